@@ -0,0 +1,43 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <cstdint>
+
+// 位棋盘：不依赖 raylib，Local / Networking / server 共用同一份规则
+//
+// 墙槽坐标 (i, j) 都是 0~7，每个方向 8×8 = 64 个槽，刚好放进一个 uint64_t
+//   水平墙槽 (i, j) 对应游戏里的 Wall{i, j + 1, true}  ：挡住第 j 行和第 j+1 行之间（第 i、i+1 列）
+//   垂直墙槽 (i, j) 对应游戏里的 Wall{i + 1, j, false} ：挡住第 i 列和第 i+1 列之间（第 j、j+1 行）
+// 贴着棋盘外框的墙（水平 y = 0 / 垂直 x = 0）挡不住任何路，不算合法墙槽
+
+const int BOARD_SIZE = 9;                       // 棋盘的尺寸
+const int CELL_COUNT = BOARD_SIZE * BOARD_SIZE; // 格子总数 81
+const int WALL_GRID = BOARD_SIZE - 1;           // 每个方向每行/列的墙槽数 8
+
+// 格子被墙挡住的方向（blocked[] 里的位）
+enum BlockDirection
+{
+    BLOCK_UP = 1,    // y - 1
+    BLOCK_DOWN = 2,  // y + 1
+    BLOCK_LEFT = 4,  // x - 1
+    BLOCK_RIGHT = 8  // x + 1
+};
+
+struct BitBoard // 位棋盘
+{
+    uint64_t hWalls;             // 水平墙槽占用，位 = i * 8 + j
+    uint64_t vWalls;             // 垂直墙槽占用，位 = i * 8 + j
+    uint8_t blocked[CELL_COUNT]; // 每个格子被挡住的方向（预计算），下标 = CellIndex(x, y)
+};
+// BitBoard board = {}; 就是空棋盘
+
+constexpr int CellIndex(int x, int y) { return x * BOARD_SIZE + y; } // 和原来 BFS 的 visited key 一致
+constexpr int SlotBit(int i, int j) { return i * WALL_GRID + j; }
+
+void ClearBoard(BitBoard &board);                                        // 清空所有墙壁
+bool WallToSlot(int x, int y, bool horizontal, int &i, int &j);          // 游戏墙壁坐标 -> 墙槽，超出范围返回 false
+bool CanPlaceWall(const BitBoard &board, int x, int y, bool horizontal); // 范围 + 重叠检查（两次掩码 AND）
+bool PlaceWall(BitBoard &board, int x, int y, bool horizontal);          // 放置墙壁并更新格子阻挡掩码，非法墙槽返回 false
+bool IsMoveBlocked(const BitBoard &board, int x, int y, int nx, int ny); // 相邻两格之间是否被墙挡住，O(1)
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include "board.h"
+#include "path.h"
+#include "legal_walls.h"
+
+// 不依赖 raylib 的完整局面：AI 搜索、自对弈和规则测试都用它
+// 玩家 0 = 白色（从 x = 0 出发，目标 x = 8），玩家 1 = 黑色（从 x = 8 出发，目标 x = 0）
+
+const int WALLS_PER_PLAYER = 10;                                  // 每个玩家开局持有的墙壁
+const int MAX_PAWN_MOVES = 6;                                     // 走棋最多 6 个选项（和 AnalyzeValidMoves 一致）
+const int MAX_MOVES = MAX_PAWN_MOVES + 2 * WALL_GRID * WALL_GRID; // 走棋 + 128 个墙槽
+
+// 和客户端协议的 Action-Type 一致：1 = 移动，2 = 放墙
+const int MOVE_PAWN = 1;
+const int MOVE_WALL = 2;
+
+struct Move
+{
+    uint8_t type;    // MOVE_PAWN / MOVE_WALL
+    int8_t x, y;     // 移动：目标格子；放墙：游戏墙壁坐标（和 Wall 一样）
+    bool horizontal; // 只对墙壁有效
+};
+
+struct GameState
+{
+    BitBoard board;
+    int x[2], y[2];             // 两个玩家的位置
+    int wallsLeft[2];           // 剩余墙壁
+    int turn;                   // 轮到谁：0 / 1
+    DistanceField field[2];     // 两个玩家到各自终点的距离场
+    LegalWallSet legalWalls;    // 合法墙槽（按需刷新，见 stale）
+    bool stale[2];              // 玩家 k 的封路墙槽还没按最新局面重算
+    uint64_t hash;              // Zobrist 哈希：位置 + 墙壁 + 剩余墙数 + 轮次
+};
+
+// 走棋规则：和原来的 AnalyzeValidMoves 完全一样（包括跳跃和斜跳），结果按同样的顺序写进 cells（格子下标）
+int PawnMoves(const BitBoard &board, int x, int y, int opponentX, int opponentY, uint8_t cells[MAX_PAWN_MOVES]);
+
+void NewGame(GameState &state); // 开局
+// 按给定的棋盘和位置重建局面（距离场、合法墙槽、哈希全部重算），UI 里的局面交给 AI 时用
+void SetupGame(GameState &state, const BitBoard &board, int x0, int y0, int x1, int y1, int wallsLeft0, int wallsLeft1, int turn);
+
+int GenerateMoves(GameState &state, Move moves[MAX_MOVES]); // 当前玩家所有合法着法（先走棋后放墙），会刷新过期的合法墙槽
+bool IsMoveLegal(GameState &state, const Move &move);        // 检查一步棋是否合法
+void ApplyMove(GameState &state, const Move &move);          // 执行一步（不检查合法性），轮到对方
+int Winner(const GameState &state);                          // 0 / 1 获胜，还没结束返回 -1
+
+// 和 IsMoveLegal 结果一样，但不刷新合法墙槽、不改 state：放墙只查重叠和双方的最短路（服务器逐步检查用）
+bool IsSingleMoveLegal(const GameState &state, const Move &move);
+
+// 着法的文本写法（自对弈记录等用）：移动 "m" + x + y，放墙 "h" / "v" + x + y，例如 m14、h35、v62
+void FormatMove(const Move &move, char text[4]); // 写 3 个字符 + '\0'
+bool ParseMove(const char *text, Move &move);     // 格式不对返回 false（不检查合法性）
+
+// 联机协议里的二进制着法：1 字节着法编码 + 2 字节序号（小端），客户端和服务器共用
+// 着法编码：0 = 无，1 ~ 81 = 移动到格子 CellIndex + 1，82 ~ 145 = 水平墙槽 + 82，146 ~ 209 = 垂直墙槽 + 146
+// 序号 = 这一步之前这一局已经走了几步，服务器用它排除重发和乱序的包
+const int MOVE_PACKET_BYTES = 3;
+
+uint8_t EncodeMoveCode(const Move &move);      // 坐标越界（包括边框上的墙）返回 0
+bool DecodeMoveCode(uint8_t code, Move &move); // 0 和大于 209 的编码返回 false
+void EncodeMovePacket(const Move &move, uint16_t seq, uint8_t packet[MOVE_PACKET_BYTES]);
+bool DecodeMovePacket(const uint8_t packet[MOVE_PACKET_BYTES], Move &move, uint16_t &seq);
+
+inline int TargetColumn(int player) { return player == 0 ? BOARD_SIZE - 1 : 0; }
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef LEGAL_WALLS_H
+#define LEGAL_WALLS_H
+
+#include "board.h"
+#include "path.h"
+
+// 当前所有合法墙槽的集合：水平 64 位 + 垂直 64 位 = 128 个槽（位 = SlotBit(i, j)）
+// 悬停预览、点击放墙、AI 和服务器都直接查这个集合，不用每次再跑 BFS
+//
+// 合法 = 没和已有的墙重叠（纯位运算） && 不会封死任何一个玩家
+// 只有切到玩家当前最短路的墙才可能封死他，所以每次只对这些槽跑 BFS：
+//   玩家 k 移动之后  -> UpdateLegalWalls(set, board, k, ...)       只重算玩家 k
+//   任意一方放墙之后 -> 先更新两个距离场，再对两个玩家各调用一次
+struct LegalWallSet
+{
+    uint64_t h, v;                 // 合法的水平 / 垂直墙槽
+    uint64_t blockH[2], blockV[2]; // 会封死玩家 0 / 1 的墙槽（只在他最短路经过的空槽里找）
+};
+
+// 从头建一个集合（开局或重置时用）
+LegalWallSet NewLegalWallSet(const BitBoard &board, int p1x, int p1y, const DistanceField &p1Field, int p2x, int p2y, const DistanceField &p2Field);
+
+// 玩家 player（0 / 1）站在 (px, py)、距离场为 field 时，重算会封死他的墙槽，再刷新 h / v
+void UpdateLegalWalls(LegalWallSet &set, const BitBoard &board, int player, int px, int py, const DistanceField &field);
+
+bool IsWallLegal(const LegalWallSet &set, int x, int y, bool horizontal);                // 游戏墙壁坐标是否合法，O(1)
+bool WallBlocksPlayer(const LegalWallSet &set, int player, int x, int y, bool horizontal); // 这面墙是否会封死玩家 player（重叠的墙槽不算）
+int CountLegalWalls(const LegalWallSet &set);                                             // 合法墙槽数量
+
+// 玩家从 (px, py) 沿距离场走的那条最短路，会被哪些墙槽切断（AI 排序着法时优先试这些墙）
+void ShortestPathSlots(const BitBoard &board, const DistanceField &field, int px, int py, uint64_t &h, uint64_t &v);
+
+#endif
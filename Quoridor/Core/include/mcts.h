@@ -0,0 +1,48 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "game_state.h"
+#include <atomic>
+#include <vector>
+
+// 蒙特卡洛树搜索（MCTS）AI：UCT 选择 + 沿最短路走的快速模拟
+// 多线程用树并行：所有线程共用一棵树，选中的节点先记一次“虚拟失败”，让别的线程去试其他分支
+
+struct MctsNode
+{
+    Move move;                    // 走到这个节点的着法
+    std::atomic<int> visits;      // 访问次数（选择时就先加上，作为虚拟失败）
+    std::atomic<int> wins;        // 走这一步的玩家在模拟中获胜的次数
+    std::atomic<int> expandState; // 0 = 未展开，1 = 某个线程正在展开，2 = 已展开，3 = 展开不了（池满或无棋可走），一直当叶子
+    int firstChild;               // 子节点在节点池里的起始下标（expandState == 2 之后才有效）
+    int childCount;
+};
+
+struct MctsTree // 预分配的节点池，每次搜索从头用起
+{
+    std::vector<MctsNode> nodes;
+    std::atomic<int> used;
+};
+
+struct MctsLimits
+{
+    int playouts; // 模拟次数预算，<= 0 表示不限
+    int timeMs;   // 时间预算（毫秒），<= 0 表示不限；两个都给时先到先停
+    int threads;  // 线程数
+};
+
+struct MctsResult
+{
+    Move best;          // 根节点访问次数最多的着法（type = 0 表示无棋可走）
+    double winRate;     // 这一步的模拟胜率
+    long long playouts; // 总模拟次数
+    int treeNodes;      // 用掉的节点数
+    double seconds;     // 用时
+};
+
+void InitMctsTree(MctsTree &tree, int maxNodes); // 分配节点池
+
+// 从 state 开始搜索，直到模拟次数或时间用完；state 不会被修改
+MctsResult MctsSearch(const GameState &state, const MctsLimits &limits, MctsTree &tree);
+
+#endif
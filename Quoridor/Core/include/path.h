@@ -0,0 +1,47 @@
+#ifndef PATH_H
+#define PATH_H
+
+#include "board.h"
+
+// 128 位格子集合（81 个格子，下标 = CellIndex(x, y)），用来做 BFS 的 visited 标记
+struct CellMask
+{
+    uint64_t lo, hi;
+};
+
+inline bool TestCell(const CellMask &mask, int cell)
+{
+    return cell < 64 ? (mask.lo >> cell) & 1 : (mask.hi >> (cell - 64)) & 1;
+}
+
+inline void SetCell(CellMask &mask, int cell)
+{
+    if (cell < 64)
+        mask.lo |= 1ULL << cell;
+    else
+        mask.hi |= 1ULL << (cell - 64);
+}
+
+// 从 (x, y) 出发能不能走到第 targetX 列（只看墙壁，不看对手棋子）
+// 队列和 visited 都在栈上，不做任何堆分配；一碰到目标列就立刻返回
+bool HasPathToGoal(const BitBoard &board, int x, int y, int targetX);
+
+// 格子 cell 往 BLOCK_* 方向可以走到的相邻格子（已去掉棋盘边界和墙壁），返回方向位
+int OpenDirections(const BitBoard &board, int cell);
+
+const uint8_t UNREACHABLE = 0xFF; // 距离场里走不到目标列的格子
+
+struct DistanceField // 每个格子到目标列的最短步数（只看墙壁），只有放墙时才会变
+{
+    int targetX;
+    uint8_t dist[CELL_COUNT]; // 下标 = CellIndex(x, y)
+};
+
+DistanceField NewDistanceField(const BitBoard &board, int targetX);                                   // 从目标列反向 BFS，整张重算
+void UpdateDistanceField(const BitBoard &board, int x, int y, bool horizontal, DistanceField &field); // 墙 (x, y) 已经放进 board 之后增量更新，只重算受影响的区域
+
+// 放下墙 (x, y) 之后 (px, py) 还能不能到达目标列；board 是放墙之前的棋盘
+// 沿距离场走一条最短路，墙没切到这条路就直接返回，否则再跑一次 BFS
+bool PathSurvivesWall(const BitBoard &board, const DistanceField &field, int px, int py, int x, int y, bool horizontal);
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include "game_state.h"
+#include "search.h"
+#include "mcts.h"
+
+// 无界面对局：几种可替换的走棋策略 + 从开局下到分出胜负的对局循环（selfplay 工具用）
+
+const int POLICY_RANDOM = 0; // 随机合法着法
+const int POLICY_GREEDY = 1; // 沿最短路走；对手比自己快时放一面最拖慢对手的墙
+const int POLICY_SEARCH = 2; // alpha-beta 搜索（单线程）
+const int POLICY_MCTS = 3;   // 蒙特卡洛树搜索（单线程）
+
+const int MAX_GAME_PLIES = 400; // 一局最多走这么多步，超过算和棋
+
+struct PolicyConfig
+{
+    int type;     // POLICY_xxx
+    int depth;    // alpha-beta 的深度
+    int timeMs;   // alpha-beta / MCTS 每步时间预算，<= 0 表示不限
+    int playouts; // MCTS 每步模拟次数
+};
+
+struct PolicyWorker // 每个线程一份：随机数状态和 AI 用的表，第一次用到时才分配
+{
+    uint64_t rng;
+    TranspositionTable tt;
+    MctsTree tree;
+    bool ttReady;
+    bool treeReady;
+};
+
+struct GameRecord
+{
+    int winner; // 0 / 1，和棋是 -1
+    int plies;  // 总步数
+    Move moves[MAX_GAME_PLIES];
+};
+
+// 解析策略名：random、greedy、search[:深度]、mcts[:模拟次数]，不认识返回 false
+bool ParsePolicy(const char *text, PolicyConfig &config);
+void InitPolicyWorker(PolicyWorker &worker, uint64_t seed);
+
+Move ChooseMove(const PolicyConfig &config, PolicyWorker &worker, GameState &state); // 轮到的玩家按策略选一步（type = 0 表示无棋可走）
+
+// 从开局下完一局：players[0] 执白，players[1] 执黑；每局开始时用 seed 重设随机数
+// random / greedy / search 的对局可以按 seed 复现，MCTS 的模拟用自己的随机数，不保证
+void PlayGame(const PolicyConfig players[2], PolicyWorker &worker, uint64_t seed, GameRecord &record);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "game_state.h"
+#include <atomic>
+#include <vector>
+
+// AI 对手：negamax alpha-beta + 迭代加深 + 置换表（Zobrist 哈希）
+// 局面评估 = 双方最短路步数之差（从当前走棋方看）+ 剩余墙壁之差
+// 多线程用 Lazy SMP：几个线程各自跑同样的迭代加深，只通过共享的置换表互相帮忙
+
+const int SCORE_WIN = 30000;     // 获胜分数（减去步数，越快赢越好）
+const int MAX_SEARCH_DEPTH = 32; // 迭代加深的深度上限
+
+// 置换表条目：无锁，多个线程同时读写
+// data 打包了分数 / 深度 / 边界类型 / 最佳着法，check = 局面哈希 ^ data
+// 两个字段被不同线程交错写坏时 check ^ data 对不上哈希，读的一方当作没命中
+struct TTEntry
+{
+    std::atomic<uint64_t> check;
+    std::atomic<uint64_t> data;
+};
+
+struct TranspositionTable
+{
+    std::vector<TTEntry> entries; // 大小是 2 的幂，下标 = hash & mask
+    uint64_t mask;
+};
+
+struct SearchLimits
+{
+    int maxDepth; // 最大深度
+    int timeMs;   // 每步时间预算（毫秒），<= 0 表示不限时
+    int threads;  // 搜索线程数（<= 1 就是单线程）
+};
+
+struct SearchResult
+{
+    Move best;                                  // 最后一次完整搜完的迭代给出的着法（type = 0 表示无棋可走）
+    int score;                                  // 对应分数（当前走棋方视角）
+    int depth;                                  // 完整搜完的最大深度
+    long long nodes;                            // 总节点数（所有线程）
+    double seconds;                             // 总用时
+    long long depthNodes[MAX_SEARCH_DEPTH + 1]; // 搜完第 d 层时的累计节点数（所有线程）
+    double depthSeconds[MAX_SEARCH_DEPTH + 1];  // 搜完第 d 层时的累计用时
+};
+
+void InitTranspositionTable(TranspositionTable &tt, int megabytes); // 分配置换表（向下取到 2 的幂个条目）
+void ClearTranspositionTable(TranspositionTable &tt);               // 新开一局时清空
+
+int Evaluate(const GameState &state); // 静态评估，当前走棋方视角
+
+// 迭代加深搜索，直到深度或时间用完；state 不会被修改
+// 会阻塞调用的线程，界面里要放到后台线程跑（见 Local/main.cpp）
+SearchResult SearchBestMove(const GameState &state, const SearchLimits &limits, TranspositionTable &tt);
+
+#endif
@@ -0,0 +1,97 @@
+#include "board.h"
+#include <cstring>
+
+// 每个墙槽会和哪些同方向墙槽重叠（含自己），编译期算好
+struct OverlapTable
+{
+    uint64_t h[WALL_GRID * WALL_GRID];
+    uint64_t v[WALL_GRID * WALL_GRID];
+};
+
+static constexpr OverlapTable MakeOverlapTable()
+{
+    OverlapTable table = {};
+    for (int i = 0; i < WALL_GRID; i++)
+    {
+        for (int j = 0; j < WALL_GRID; j++)
+        {
+            for (int d = -1; d <= 1; d++)
+            {
+                if (i + d >= 0 && i + d < WALL_GRID)
+                    table.h[SlotBit(i, j)] |= 1ULL << SlotBit(i + d, j); // 水平墙：左右相邻的槽会重叠
+                if (j + d >= 0 && j + d < WALL_GRID)
+                    table.v[SlotBit(i, j)] |= 1ULL << SlotBit(i, j + d); // 垂直墙：上下相邻的槽会重叠
+            }
+        }
+    }
+    return table;
+}
+
+static constexpr OverlapTable overlapMask = MakeOverlapTable();
+
+void ClearBoard(BitBoard &board)
+{
+    memset(&board, 0, sizeof(BitBoard));
+}
+
+bool WallToSlot(int x, int y, bool horizontal, int &i, int &j)
+{
+    if (horizontal)
+    {
+        i = x;
+        j = y - 1;
+    }
+    else
+    {
+        i = x - 1;
+        j = y;
+    }
+    return i >= 0 && i < WALL_GRID && j >= 0 && j < WALL_GRID;
+}
+
+bool CanPlaceWall(const BitBoard &board, int x, int y, bool horizontal)
+{
+    int i, j;
+    if (!WallToSlot(x, y, horizontal, i, j))
+        return false;
+
+    // 不同方向墙壁允许交叉，只检查同方向重叠
+    if (horizontal)
+        return (board.hWalls & overlapMask.h[SlotBit(i, j)]) == 0;
+    return (board.vWalls & overlapMask.v[SlotBit(i, j)]) == 0;
+}
+
+bool PlaceWall(BitBoard &board, int x, int y, bool horizontal)
+{
+    int i, j;
+    if (!WallToSlot(x, y, horizontal, i, j))
+        return false;
+
+    if (horizontal)
+    {
+        board.hWalls |= 1ULL << SlotBit(i, j);
+        board.blocked[CellIndex(i, j)] |= BLOCK_DOWN;
+        board.blocked[CellIndex(i + 1, j)] |= BLOCK_DOWN;
+        board.blocked[CellIndex(i, j + 1)] |= BLOCK_UP;
+        board.blocked[CellIndex(i + 1, j + 1)] |= BLOCK_UP;
+    }
+    else
+    {
+        board.vWalls |= 1ULL << SlotBit(i, j);
+        board.blocked[CellIndex(i, j)] |= BLOCK_RIGHT;
+        board.blocked[CellIndex(i, j + 1)] |= BLOCK_RIGHT;
+        board.blocked[CellIndex(i + 1, j)] |= BLOCK_LEFT;
+        board.blocked[CellIndex(i + 1, j + 1)] |= BLOCK_LEFT;
+    }
+    return true;
+}
+
+bool IsMoveBlocked(const BitBoard &board, int x, int y, int nx, int ny)
+{
+    int dir;
+    if (x == nx)
+        dir = (ny > y) ? BLOCK_DOWN : BLOCK_UP;
+    else
+        dir = (nx > x) ? BLOCK_RIGHT : BLOCK_LEFT;
+    return (board.blocked[CellIndex(x, y)] & dir) != 0;
+}
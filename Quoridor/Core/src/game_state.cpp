@@ -0,0 +1,362 @@
+#include "game_state.h"
+
+// ------------------------------Zobrist 哈希------------------------------
+
+// 编译期用 splitmix64 生成随机数，不依赖运行时初始化顺序
+struct ZobristTable
+{
+    uint64_t pawn[2][CELL_COUNT];
+    uint64_t hWall[WALL_GRID * WALL_GRID];
+    uint64_t vWall[WALL_GRID * WALL_GRID];
+    uint64_t wallsLeft[2][WALLS_PER_PLAYER + 1];
+    uint64_t turn;
+};
+
+static constexpr uint64_t SplitMix64(uint64_t &seed)
+{
+    uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static constexpr ZobristTable MakeZobristTable()
+{
+    ZobristTable table = {};
+    uint64_t seed = 0x51554F5249444F52ULL; // "QUORIDOR"
+    for (int p = 0; p < 2; p++)
+        for (int c = 0; c < CELL_COUNT; c++)
+            table.pawn[p][c] = SplitMix64(seed);
+    for (int s = 0; s < WALL_GRID * WALL_GRID; s++)
+    {
+        table.hWall[s] = SplitMix64(seed);
+        table.vWall[s] = SplitMix64(seed);
+    }
+    for (int p = 0; p < 2; p++)
+        for (int w = 0; w <= WALLS_PER_PLAYER; w++)
+            table.wallsLeft[p][w] = SplitMix64(seed);
+    table.turn = SplitMix64(seed);
+    return table;
+}
+
+static constexpr ZobristTable zobrist = MakeZobristTable();
+
+static uint64_t ComputeHash(const GameState &state)
+{
+    uint64_t hash = 0;
+    for (int p = 0; p < 2; p++)
+    {
+        hash ^= zobrist.pawn[p][CellIndex(state.x[p], state.y[p])];
+        hash ^= zobrist.wallsLeft[p][state.wallsLeft[p]];
+    }
+    for (int s = 0; s < WALL_GRID * WALL_GRID; s++)
+    {
+        if ((state.board.hWalls >> s) & 1)
+            hash ^= zobrist.hWall[s];
+        if ((state.board.vWalls >> s) & 1)
+            hash ^= zobrist.vWall[s];
+    }
+    if (state.turn)
+        hash ^= zobrist.turn;
+    return hash;
+}
+
+// ------------------------------走棋规则------------------------------
+
+int PawnMoves(const BitBoard &board, int x, int y, int opponentX, int opponentY, uint8_t cells[MAX_PAWN_MOVES])
+{
+    int count = 0; // 有效移动的计数器
+
+    // 上下左右的基本移动（不能走到对手的格子上）
+    if (x > 0 && !(x - 1 == opponentX && y == opponentY) && !IsMoveBlocked(board, x, y, x - 1, y))
+        cells[count++] = CellIndex(x - 1, y);
+    if (x < BOARD_SIZE - 1 && !(x + 1 == opponentX && y == opponentY) && !IsMoveBlocked(board, x, y, x + 1, y))
+        cells[count++] = CellIndex(x + 1, y);
+    if (y > 0 && !(x == opponentX && y - 1 == opponentY) && !IsMoveBlocked(board, x, y, x, y - 1))
+        cells[count++] = CellIndex(x, y - 1);
+    if (y < BOARD_SIZE - 1 && !(x == opponentX && y + 1 == opponentY) && !IsMoveBlocked(board, x, y, x, y + 1))
+        cells[count++] = CellIndex(x, y + 1);
+
+    // 对手在左侧：直接跳过，跳不过去就斜跳
+    if (x > 1 && (x - 1 == opponentX && y == opponentY) && !IsMoveBlocked(board, x, y, x - 1, y))
+    {
+        if (!IsMoveBlocked(board, x - 1, y, x - 2, y))
+            cells[count++] = CellIndex(x - 2, y);
+        else
+        {
+            if (y > 0 && !IsMoveBlocked(board, x - 1, y, x - 1, y - 1))
+                cells[count++] = CellIndex(x - 1, y - 1);
+            if (y < BOARD_SIZE - 1 && !IsMoveBlocked(board, x - 1, y, x - 1, y + 1))
+                cells[count++] = CellIndex(x - 1, y + 1);
+        }
+    }
+
+    // 对手在右侧
+    if (x < BOARD_SIZE - 2 && (x + 1 == opponentX && y == opponentY) && !IsMoveBlocked(board, x, y, x + 1, y))
+    {
+        if (!IsMoveBlocked(board, x + 1, y, x + 2, y))
+            cells[count++] = CellIndex(x + 2, y);
+        else
+        {
+            if (y > 0 && !IsMoveBlocked(board, x + 1, y, x + 1, y - 1))
+                cells[count++] = CellIndex(x + 1, y - 1);
+            if (y < BOARD_SIZE - 1 && !IsMoveBlocked(board, x + 1, y, x + 1, y + 1))
+                cells[count++] = CellIndex(x + 1, y + 1);
+        }
+    }
+
+    // 对手在上方
+    if (y > 1 && (x == opponentX && y - 1 == opponentY) && !IsMoveBlocked(board, x, y, x, y - 1))
+    {
+        if (!IsMoveBlocked(board, x, y - 1, x, y - 2))
+            cells[count++] = CellIndex(x, y - 2);
+        else
+        {
+            if (x > 0 && !IsMoveBlocked(board, x, y - 1, x - 1, y - 1))
+                cells[count++] = CellIndex(x - 1, y - 1);
+            if (x < BOARD_SIZE - 1 && !IsMoveBlocked(board, x, y - 1, x + 1, y - 1))
+                cells[count++] = CellIndex(x + 1, y - 1);
+        }
+    }
+
+    // 对手在下方
+    if (y < BOARD_SIZE - 2 && (x == opponentX && y + 1 == opponentY) && !IsMoveBlocked(board, x, y, x, y + 1))
+    {
+        if (!IsMoveBlocked(board, x, y + 1, x, y + 2))
+            cells[count++] = CellIndex(x, y + 2);
+        else
+        {
+            if (x > 0 && !IsMoveBlocked(board, x, y + 1, x - 1, y + 1))
+                cells[count++] = CellIndex(x - 1, y + 1);
+            if (x < BOARD_SIZE - 1 && !IsMoveBlocked(board, x, y + 1, x + 1, y + 1))
+                cells[count++] = CellIndex(x + 1, y + 1);
+        }
+    }
+
+    return count;
+}
+
+// ------------------------------局面------------------------------
+
+void NewGame(GameState &state)
+{
+    BitBoard empty = {};
+    SetupGame(state, empty, 0, 4, BOARD_SIZE - 1, 4, WALLS_PER_PLAYER, WALLS_PER_PLAYER, 0);
+}
+
+void SetupGame(GameState &state, const BitBoard &board, int x0, int y0, int x1, int y1, int wallsLeft0, int wallsLeft1, int turn)
+{
+    state.board = board;
+    state.x[0] = x0;
+    state.y[0] = y0;
+    state.x[1] = x1;
+    state.y[1] = y1;
+    state.wallsLeft[0] = wallsLeft0;
+    state.wallsLeft[1] = wallsLeft1;
+    state.turn = turn;
+    for (int p = 0; p < 2; p++)
+        state.field[p] = NewDistanceField(board, TargetColumn(p));
+    state.legalWalls = NewLegalWallSet(board, x0, y0, state.field[0], x1, y1, state.field[1]);
+    state.stale[0] = state.stale[1] = false;
+    state.hash = ComputeHash(state);
+}
+
+// 合法墙槽只在真正要生成着法时才重算（搜索的叶子节点用不到）
+static void RefreshStaleWalls(GameState &state)
+{
+    for (int p = 0; p < 2; p++)
+    {
+        if (state.stale[p])
+        {
+            UpdateLegalWalls(state.legalWalls, state.board, p, state.x[p], state.y[p], state.field[p]);
+            state.stale[p] = false;
+        }
+    }
+}
+
+int GenerateMoves(GameState &state, Move moves[MAX_MOVES])
+{
+    int me = state.turn;
+    int count = 0;
+
+    uint8_t cells[MAX_PAWN_MOVES];
+    int pawnCount = PawnMoves(state.board, state.x[me], state.y[me], state.x[1 - me], state.y[1 - me], cells);
+    for (int k = 0; k < pawnCount; k++)
+        moves[count++] = {(uint8_t)MOVE_PAWN, (int8_t)(cells[k] / BOARD_SIZE), (int8_t)(cells[k] % BOARD_SIZE), false};
+
+    if (state.wallsLeft[me] == 0)
+        return count;
+
+    RefreshStaleWalls(state);
+    for (int o = 0; o < 2; o++)
+    {
+        uint64_t slots = o == 0 ? state.legalWalls.h : state.legalWalls.v;
+        while (slots)
+        {
+            int bit = __builtin_ctzll(slots);
+            slots &= slots - 1;
+            int i = bit / WALL_GRID, j = bit % WALL_GRID;
+            if (o == 0)
+                moves[count++] = {(uint8_t)MOVE_WALL, (int8_t)i, (int8_t)(j + 1), true};
+            else
+                moves[count++] = {(uint8_t)MOVE_WALL, (int8_t)(i + 1), (int8_t)j, false};
+        }
+    }
+    return count;
+}
+
+bool IsMoveLegal(GameState &state, const Move &move)
+{
+    int me = state.turn;
+    if (move.type == MOVE_PAWN)
+    {
+        uint8_t cells[MAX_PAWN_MOVES];
+        int pawnCount = PawnMoves(state.board, state.x[me], state.y[me], state.x[1 - me], state.y[1 - me], cells);
+        for (int k = 0; k < pawnCount; k++)
+            if (cells[k] == CellIndex(move.x, move.y))
+                return true;
+        return false;
+    }
+    if (move.type == MOVE_WALL && state.wallsLeft[me] > 0)
+    {
+        RefreshStaleWalls(state);
+        return IsWallLegal(state.legalWalls, move.x, move.y, move.horizontal);
+    }
+    return false;
+}
+
+// 只检查这一步：不用整张合法墙槽表（走棋后要整体重算），放墙时沿两人的距离场各走一遍最短路
+bool IsSingleMoveLegal(const GameState &state, const Move &move)
+{
+    int me = state.turn;
+    if (move.type == MOVE_PAWN)
+    {
+        uint8_t cells[MAX_PAWN_MOVES];
+        int pawnCount = PawnMoves(state.board, state.x[me], state.y[me], state.x[1 - me], state.y[1 - me], cells);
+        for (int k = 0; k < pawnCount; k++)
+            if (cells[k] == CellIndex(move.x, move.y))
+                return true;
+        return false;
+    }
+    if (move.type != MOVE_WALL || state.wallsLeft[me] <= 0 || !CanPlaceWall(state.board, move.x, move.y, move.horizontal))
+        return false;
+    for (int p = 0; p < 2; p++)
+        if (!PathSurvivesWall(state.board, state.field[p], state.x[p], state.y[p], move.x, move.y, move.horizontal))
+            return false;
+    return true;
+}
+
+void ApplyMove(GameState &state, const Move &move)
+{
+    int me = state.turn;
+    if (move.type == MOVE_PAWN)
+    {
+        state.hash ^= zobrist.pawn[me][CellIndex(state.x[me], state.y[me])];
+        state.x[me] = move.x;
+        state.y[me] = move.y;
+        state.hash ^= zobrist.pawn[me][CellIndex(state.x[me], state.y[me])];
+        state.stale[me] = true; // 位置变了，最短路也变了
+    }
+    else
+    {
+        int i, j;
+        WallToSlot(move.x, move.y, move.horizontal, i, j);
+        state.hash ^= move.horizontal ? zobrist.hWall[SlotBit(i, j)] : zobrist.vWall[SlotBit(i, j)];
+        state.hash ^= zobrist.wallsLeft[me][state.wallsLeft[me]];
+        state.wallsLeft[me]--;
+        state.hash ^= zobrist.wallsLeft[me][state.wallsLeft[me]];
+
+        PlaceWall(state.board, move.x, move.y, move.horizontal);
+        for (int p = 0; p < 2; p++)
+        {
+            UpdateDistanceField(state.board, move.x, move.y, move.horizontal, state.field[p]);
+            state.stale[p] = true;
+        }
+    }
+    state.turn = 1 - me;
+    state.hash ^= zobrist.turn;
+}
+
+int Winner(const GameState &state)
+{
+    if (state.x[0] == TargetColumn(0))
+        return 0;
+    if (state.x[1] == TargetColumn(1))
+        return 1;
+    return -1;
+}
+
+// ------------------------------着法文本------------------------------
+
+void FormatMove(const Move &move, char text[4])
+{
+    text[0] = move.type == MOVE_PAWN ? 'm' : (move.horizontal ? 'h' : 'v');
+    text[1] = (char)('0' + move.x);
+    text[2] = (char)('0' + move.y);
+    text[3] = '\0';
+}
+
+bool ParseMove(const char *text, Move &move)
+{
+    if (text[0] != 'm' && text[0] != 'h' && text[0] != 'v')
+        return false;
+    if (text[1] < '0' || text[1] > '9' || text[2] < '0' || text[2] > '9')
+        return false;
+    move.type = text[0] == 'm' ? MOVE_PAWN : MOVE_WALL;
+    move.x = (int8_t)(text[1] - '0');
+    move.y = (int8_t)(text[2] - '0');
+    move.horizontal = text[0] == 'h';
+    return true;
+}
+
+// ------------------------------二进制着法------------------------------
+
+const int CODE_PAWN = 1;                                           // 移动编码的起点
+const int CODE_HORIZONTAL = CODE_PAWN + CELL_COUNT;                // 水平墙编码的起点 82
+const int CODE_VERTICAL = CODE_HORIZONTAL + WALL_GRID * WALL_GRID; // 垂直墙编码的起点 146
+const int CODE_END = CODE_VERTICAL + WALL_GRID * WALL_GRID;        // 210
+
+uint8_t EncodeMoveCode(const Move &move)
+{
+    if (move.type == MOVE_PAWN)
+    {
+        if (move.x < 0 || move.x >= BOARD_SIZE || move.y < 0 || move.y >= BOARD_SIZE)
+            return 0;
+        return (uint8_t)(CODE_PAWN + CellIndex(move.x, move.y));
+    }
+    int i, j;
+    if (move.type != MOVE_WALL || !WallToSlot(move.x, move.y, move.horizontal, i, j))
+        return 0;
+    return (uint8_t)((move.horizontal ? CODE_HORIZONTAL : CODE_VERTICAL) + SlotBit(i, j));
+}
+
+bool DecodeMoveCode(uint8_t code, Move &move)
+{
+    if (code < CODE_PAWN || code >= CODE_END)
+        return false;
+    if (code < CODE_HORIZONTAL)
+    {
+        int cell = code - CODE_PAWN;
+        move = Move{(uint8_t)MOVE_PAWN, (int8_t)(cell / BOARD_SIZE), (int8_t)(cell % BOARD_SIZE), false};
+        return true;
+    }
+    bool horizontal = code < CODE_VERTICAL;
+    int bit = code - (horizontal ? CODE_HORIZONTAL : CODE_VERTICAL);
+    int i = bit / WALL_GRID, j = bit % WALL_GRID;
+    move = horizontal ? Move{(uint8_t)MOVE_WALL, (int8_t)i, (int8_t)(j + 1), true}
+                      : Move{(uint8_t)MOVE_WALL, (int8_t)(i + 1), (int8_t)j, false};
+    return true;
+}
+
+void EncodeMovePacket(const Move &move, uint16_t seq, uint8_t packet[MOVE_PACKET_BYTES])
+{
+    packet[0] = EncodeMoveCode(move);
+    packet[1] = (uint8_t)(seq & 0xFF);
+    packet[2] = (uint8_t)(seq >> 8);
+}
+
+bool DecodeMovePacket(const uint8_t packet[MOVE_PACKET_BYTES], Move &move, uint16_t &seq)
+{
+    seq = (uint16_t)(packet[1] | (packet[2] << 8));
+    return DecodeMoveCode(packet[0], move);
+}
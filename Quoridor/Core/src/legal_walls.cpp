@@ -0,0 +1,175 @@
+#include "legal_walls.h"
+
+// 墙槽位 = i * 8 + j，j 相同的槽组成一“列”
+const uint64_t SLOT_J_FIRST = 0x0101010101010101ULL; // j == 0 的所有槽
+const uint64_t SLOT_J_LAST = 0x8080808080808080ULL;  // j == 7 的所有槽
+
+// 没和已有墙重叠的水平墙槽：水平墙和左右相邻（i ± 1，位 ± 8）的槽重叠
+static uint64_t FreeHorizontalSlots(const BitBoard &board)
+{
+    uint64_t used = board.hWalls;
+    return ~(used | (used << WALL_GRID) | (used >> WALL_GRID));
+}
+
+// 没和已有墙重叠的垂直墙槽：垂直墙和上下相邻（j ± 1，位 ± 1）的槽重叠，不能跨到下一个 i
+static uint64_t FreeVerticalSlots(const BitBoard &board)
+{
+    uint64_t used = board.vWalls;
+    return ~(used | ((used << 1) & ~SLOT_J_FIRST) | ((used >> 1) & ~SLOT_J_LAST));
+}
+
+// 沿距离场往下走，和 PathSurvivesWall 走的是同一条路
+void ShortestPathSlots(const BitBoard &board, const DistanceField &field, int px, int py, uint64_t &h, uint64_t &v)
+{
+    h = v = 0;
+    int x = px, y = py;
+    if (field.dist[CellIndex(x, y)] == UNREACHABLE)
+        return;
+
+    while (field.dist[CellIndex(x, y)] > 0)
+    {
+        int cell = CellIndex(x, y);
+        int open = OpenDirections(board, cell);
+        int nx = x, ny = y;
+        if ((open & BLOCK_UP) && field.dist[cell - 1] + 1 == field.dist[cell])
+            ny = y - 1;
+        else if ((open & BLOCK_DOWN) && field.dist[cell + 1] + 1 == field.dist[cell])
+            ny = y + 1;
+        else if ((open & BLOCK_LEFT) && field.dist[cell - BOARD_SIZE] + 1 == field.dist[cell])
+            nx = x - 1;
+        else
+            nx = x + 1;
+
+        if (nx == x)
+        {
+            // (x, minY) 和 (x, minY + 1) 之间的边：水平墙槽 (x - 1, minY) 和 (x, minY)
+            int minY = y < ny ? y : ny;
+            if (x > 0)
+                h |= 1ULL << SlotBit(x - 1, minY);
+            if (x < WALL_GRID)
+                h |= 1ULL << SlotBit(x, minY);
+        }
+        else
+        {
+            // (minX, y) 和 (minX + 1, y) 之间的边：垂直墙槽 (minX, y - 1) 和 (minX, y)
+            int minX = x < nx ? x : nx;
+            if (y > 0)
+                v |= 1ULL << SlotBit(minX, y - 1);
+            if (y < WALL_GRID)
+                v |= 1ULL << SlotBit(minX, y);
+        }
+        x = nx;
+        y = ny;
+    }
+}
+
+static void RefreshLegalWalls(LegalWallSet &set, const BitBoard &board)
+{
+    set.h = FreeHorizontalSlots(board) & ~(set.blockH[0] | set.blockH[1]);
+    set.v = FreeVerticalSlots(board) & ~(set.blockV[0] | set.blockV[1]);
+}
+
+// 墙的端点和中点落在 10×10 的格线交点上，下标 = px * 10 + py（px 是列线 0~9，py 是行线 0~9）
+const int POINT_GRID = BOARD_SIZE + 1;
+
+// 墙槽的三个交点：水平墙槽 (i, j) 在行线 j+1 上从列线 i 到 i+2，垂直墙槽 (i, j) 在列线 i+1 上从行线 j 到 j+2
+static void SlotPoints(int i, int j, bool horizontal, int points[3])
+{
+    for (int k = 0; k < 3; k++)
+        points[k] = horizontal ? (i + k) * POINT_GRID + (j + 1) : (i + 1) * POINT_GRID + (j + k);
+}
+
+// 已有墙壁和棋盘边框占用的交点
+static CellMask TouchedPoints(const BitBoard &board)
+{
+    CellMask touched = {0, 0};
+    for (int p = 0; p < POINT_GRID; p++)
+    {
+        SetCell(touched, p);                                 // 左边框（列线 0）
+        SetCell(touched, (POINT_GRID - 1) * POINT_GRID + p); // 右边框（列线 9）
+        SetCell(touched, p * POINT_GRID);                    // 上边框（行线 0）
+        SetCell(touched, p * POINT_GRID + POINT_GRID - 1);   // 下边框（行线 9）
+    }
+    for (int o = 0; o < 2; o++)
+    {
+        uint64_t walls = o == 0 ? board.hWalls : board.vWalls;
+        while (walls)
+        {
+            int bit = __builtin_ctzll(walls);
+            walls &= walls - 1;
+            int points[3];
+            SlotPoints(bit / WALL_GRID, bit % WALL_GRID, o == 0, points);
+            for (int k = 0; k < 3; k++)
+                SetCell(touched, points[k]);
+        }
+    }
+    return touched;
+}
+
+// 逐个检查 candidates 里的墙槽，返回其中会封死玩家的那些
+// 新墙只有在至少两个交点碰到已有的墙或边框时才可能围出一块封闭区域，其余的不用跑 BFS
+static uint64_t BlockingSlots(const BitBoard &board, const CellMask &touched, uint64_t candidates, bool horizontal, int px, int py, int targetX)
+{
+    uint64_t blocking = 0;
+    while (candidates)
+    {
+        int bit = __builtin_ctzll(candidates);
+        candidates &= candidates - 1;
+
+        int i = bit / WALL_GRID, j = bit % WALL_GRID;
+        int points[3];
+        SlotPoints(i, j, horizontal, points);
+        if (TestCell(touched, points[0]) + TestCell(touched, points[1]) + TestCell(touched, points[2]) < 2)
+            continue;
+
+        BitBoard after = board;
+        if (horizontal)
+            PlaceWall(after, i, j + 1, true);
+        else
+            PlaceWall(after, i + 1, j, false);
+        if (!HasPathToGoal(after, px, py, targetX))
+            blocking |= 1ULL << bit;
+    }
+    return blocking;
+}
+
+void UpdateLegalWalls(LegalWallSet &set, const BitBoard &board, int player, int px, int py, const DistanceField &field)
+{
+    uint64_t pathH, pathV;
+    ShortestPathSlots(board, field, px, py, pathH, pathV);
+
+    // 没切到最短路的墙一定封不死他；已经重叠的槽本来就不合法，也不用查
+    CellMask touched = TouchedPoints(board);
+    set.blockH[player] = BlockingSlots(board, touched, pathH & FreeHorizontalSlots(board), true, px, py, field.targetX);
+    set.blockV[player] = BlockingSlots(board, touched, pathV & FreeVerticalSlots(board), false, px, py, field.targetX);
+    RefreshLegalWalls(set, board);
+}
+
+LegalWallSet NewLegalWallSet(const BitBoard &board, int p1x, int p1y, const DistanceField &p1Field, int p2x, int p2y, const DistanceField &p2Field)
+{
+    LegalWallSet set = {};
+    UpdateLegalWalls(set, board, 0, p1x, p1y, p1Field);
+    UpdateLegalWalls(set, board, 1, p2x, p2y, p2Field);
+    return set;
+}
+
+bool IsWallLegal(const LegalWallSet &set, int x, int y, bool horizontal)
+{
+    int i, j;
+    if (!WallToSlot(x, y, horizontal, i, j))
+        return false;
+    return ((horizontal ? set.h : set.v) >> SlotBit(i, j)) & 1;
+}
+
+bool WallBlocksPlayer(const LegalWallSet &set, int player, int x, int y, bool horizontal)
+{
+    int i, j;
+    if (!WallToSlot(x, y, horizontal, i, j))
+        return false;
+    return ((horizontal ? set.blockH[player] : set.blockV[player]) >> SlotBit(i, j)) & 1;
+}
+
+int CountLegalWalls(const LegalWallSet &set)
+{
+    return __builtin_popcountll(set.h) + __builtin_popcountll(set.v);
+}
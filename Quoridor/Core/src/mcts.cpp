@@ -0,0 +1,338 @@
+#include "mcts.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+const int EXPAND_VISITS = 2;         // 节点被访问到第 2 次才展开（第一次只做模拟）
+const int MAX_PLAYOUT_PLIES = 160;   // 模拟最多走这么多步，之后按最短路判胜负
+const double UCT_EXPLORATION = 1.0;  // UCT 探索系数
+const double FIRST_PLAY_VALUE = 1.0; // 没访问过的子节点的 UCT 值：已有分支看起来不好时才去试新着法
+const int MAX_TREE_DEPTH = 256;
+
+// ------------------------------随机数------------------------------
+
+static uint32_t NextRandom(uint64_t &state) // xorshift64*
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (uint32_t)((state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+// ------------------------------模拟------------------------------
+
+// 双方都没有墙了：只剩赛跑，先走的一方步数不多于对手就赢（不考虑跳跃）
+static int RaceWinner(const GameState &state)
+{
+    int me = state.turn, opponent = 1 - me;
+    int myDistance = state.field[me].dist[CellIndex(state.x[me], state.y[me])];
+    int opponentDistance = state.field[opponent].dist[CellIndex(state.x[opponent], state.y[opponent])];
+    return myDistance <= opponentDistance ? me : opponent;
+}
+
+// 沿最短路走一步（距离相同的格子随机挑一个）
+static bool PickPawnMove(const GameState &state, uint64_t &rng, Move &move)
+{
+    int me = state.turn;
+    uint8_t cells[MAX_PAWN_MOVES];
+    int count = PawnMoves(state.board, state.x[me], state.y[me], state.x[1 - me], state.y[1 - me], cells);
+    if (count == 0)
+        return false;
+
+    int best = -1, bestDistance = UNREACHABLE + 1, ties = 0;
+    for (int k = 0; k < count; k++)
+    {
+        int distance = state.field[me].dist[cells[k]];
+        if (distance < bestDistance)
+        {
+            best = k;
+            bestDistance = distance;
+            ties = 1;
+        }
+        else if (distance == bestDistance && NextRandom(rng) % ++ties == 0)
+            best = k;
+    }
+    move = {(uint8_t)MOVE_PAWN, (int8_t)(cells[best] / BOARD_SIZE), (int8_t)(cells[best] % BOARD_SIZE), false};
+    return true;
+}
+
+// 在对手最短路上随机挑一面合法的墙
+static bool PickWall(const GameState &state, uint64_t &rng, Move &move)
+{
+    int opponent = 1 - state.turn;
+    uint64_t cutH, cutV;
+    ShortestPathSlots(state.board, state.field[opponent], state.x[opponent], state.y[opponent], cutH, cutV);
+    int total = __builtin_popcountll(cutH) + __builtin_popcountll(cutV);
+    if (total == 0)
+        return false;
+
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        int pick = NextRandom(rng) % total;
+        int countH = __builtin_popcountll(cutH);
+        bool horizontal = pick < countH;
+        uint64_t slots = horizontal ? cutH : cutV;
+        if (!horizontal)
+            pick -= countH;
+        while (pick-- > 0)
+            slots &= slots - 1;
+        int bit = __builtin_ctzll(slots);
+        int i = bit / WALL_GRID, j = bit % WALL_GRID;
+
+        if (horizontal)
+            move = {(uint8_t)MOVE_WALL, (int8_t)i, (int8_t)(j + 1), true};
+        else
+            move = {(uint8_t)MOVE_WALL, (int8_t)(i + 1), (int8_t)j, false};
+        // 只检查这一面墙，比刷新整个合法墙槽集合便宜
+        if (CanPlaceWall(state.board, move.x, move.y, move.horizontal) &&
+            PathSurvivesWall(state.board, state.field[0], state.x[0], state.y[0], move.x, move.y, move.horizontal) &&
+            PathSurvivesWall(state.board, state.field[1], state.x[1], state.y[1], move.x, move.y, move.horizontal))
+            return true;
+    }
+    return false;
+}
+
+// 快速模拟到终局，返回获胜的玩家：大多数时候沿最短路走，偶尔往对手的路上放墙
+static int Playout(GameState &state, uint64_t &rng)
+{
+    for (int ply = 0; ply < MAX_PLAYOUT_PLIES; ply++)
+    {
+        int winner = Winner(state);
+        if (winner >= 0)
+            return winner;
+        if (state.wallsLeft[0] == 0 && state.wallsLeft[1] == 0)
+            return RaceWinner(state);
+
+        Move move;
+        bool wall = state.wallsLeft[state.turn] > 0 && NextRandom(rng) % 4 == 0 && PickWall(state, rng, move);
+        if (!wall && !PickPawnMove(state, rng, move))
+            return 1 - state.turn; // 被围住无棋可走，算输
+        ApplyMove(state, move);
+    }
+    return RaceWinner(state);
+}
+
+// ------------------------------树------------------------------
+
+void InitMctsTree(MctsTree &tree, int maxNodes)
+{
+    tree.nodes = std::vector<MctsNode>(maxNodes);
+    tree.used.store(0);
+}
+
+static void ResetNode(MctsNode &node, const Move &move)
+{
+    node.move = move;
+    node.visits.store(0, std::memory_order_relaxed);
+    node.wins.store(0, std::memory_order_relaxed);
+    node.expandState.store(0, std::memory_order_relaxed);
+    node.firstChild = 0;
+    node.childCount = 0;
+}
+
+// 子节点排序：沿最短路的走棋 > 切断对手最短路的墙 > 其他走棋 > 其他墙
+// 没访问过的子节点按这个顺序试，好着法先拿到模拟次数
+static void OrderChildren(const GameState &state, Move moves[], int count)
+{
+    int me = state.turn, opponent = 1 - me;
+    int myDistance = state.field[me].dist[CellIndex(state.x[me], state.y[me])];
+    uint64_t cutH, cutV;
+    ShortestPathSlots(state.board, state.field[opponent], state.x[opponent], state.y[opponent], cutH, cutV);
+
+    Move ordered[MAX_MOVES];
+    int used = 0;
+    for (int pass = 0; pass < 4; pass++)
+    {
+        for (int k = 0; k < count; k++)
+        {
+            const Move &m = moves[k];
+            int group;
+            if (m.type == MOVE_PAWN)
+                group = state.field[me].dist[CellIndex(m.x, m.y)] < myDistance ? 0 : 2;
+            else
+            {
+                int i, j;
+                WallToSlot(m.x, m.y, m.horizontal, i, j);
+                group = ((m.horizontal ? cutH : cutV) >> SlotBit(i, j)) & 1 ? 1 : 3;
+            }
+            if (group == pass)
+                ordered[used++] = m;
+        }
+    }
+    for (int k = 0; k < count; k++)
+        moves[k] = ordered[k];
+}
+
+// 展开节点：所有合法着法各建一个子节点；节点池放不下（或者无棋可走）就永远当叶子，不再重试
+static void Expand(MctsTree &tree, int index, GameState &state)
+{
+    MctsNode &node = tree.nodes[index];
+    int expected = 0;
+    if (!node.expandState.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+        return; // 别的线程已经在展开
+
+    int capacity = (int)tree.nodes.size();
+    if (tree.used.load(std::memory_order_relaxed) >= capacity) // 池已经满了，连着法都不用生成
+    {
+        node.expandState.store(3, std::memory_order_release);
+        return;
+    }
+    Move moves[MAX_MOVES];
+    int count = GenerateMoves(state, moves);
+
+    // 放得下才占位（CAS），used 不会超过 capacity，也就不会溢出
+    int first = tree.used.load(std::memory_order_relaxed);
+    do
+    {
+        if (count == 0 || first + count > capacity)
+        {
+            node.expandState.store(3, std::memory_order_release);
+            return;
+        }
+    } while (!tree.used.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+
+    OrderChildren(state, moves, count);
+    for (int k = 0; k < count; k++)
+        ResetNode(tree.nodes[first + k], moves[k]);
+    node.firstChild = first;
+    node.childCount = count;
+    node.expandState.store(2, std::memory_order_release);
+}
+
+// UCT：胜率 + 探索项；同分时取排在前面的子节点
+static int SelectChild(MctsTree &tree, int index)
+{
+    const MctsNode &node = tree.nodes[index];
+    double logVisits = std::log((double)node.visits.load(std::memory_order_relaxed) + 1);
+    int best = node.firstChild;
+    double bestValue = -1;
+    for (int k = node.firstChild; k < node.firstChild + node.childCount; k++)
+    {
+        const MctsNode &child = tree.nodes[k];
+        int visits = child.visits.load(std::memory_order_relaxed);
+        double value = FIRST_PLAY_VALUE;
+        if (visits > 0)
+            value = (double)child.wins.load(std::memory_order_relaxed) / visits + UCT_EXPLORATION * std::sqrt(logVisits / visits);
+        if (value > bestValue)
+        {
+            bestValue = value;
+            best = k;
+        }
+    }
+    return best;
+}
+
+struct MctsShared
+{
+    MctsTree *tree;
+    const GameState *root;
+    MctsLimits limits;
+    std::chrono::steady_clock::time_point start;
+    std::atomic<long long> playouts; // 已经开始的模拟次数
+    std::atomic<bool> stop;
+};
+
+static void MctsWorker(MctsShared *shared, int id)
+{
+    MctsTree &tree = *shared->tree;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL * (id + 1) + (uint64_t)shared->start.time_since_epoch().count();
+    int path[MAX_TREE_DEPTH];
+    int movers[MAX_TREE_DEPTH];
+
+    for (long long iteration = 0; !shared->stop.load(std::memory_order_relaxed); iteration++)
+    {
+        long long started = shared->playouts.fetch_add(1, std::memory_order_relaxed);
+        if (shared->limits.playouts > 0 && started >= shared->limits.playouts)
+            break;
+        if (shared->limits.timeMs > 0 && (iteration & 15) == 0)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - shared->start;
+            if (std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= shared->limits.timeMs)
+                shared->stop.store(true, std::memory_order_relaxed);
+        }
+
+        // 1. 选择：沿 UCT 往下走，每经过一个节点先加一次访问（虚拟失败）
+        GameState state = *shared->root;
+        int depth = 0;
+        int index = 0;
+        tree.nodes[0].visits.fetch_add(1, std::memory_order_relaxed);
+        while (depth < MAX_TREE_DEPTH - 1 && Winner(state) < 0)
+        {
+            MctsNode &node = tree.nodes[index];
+            int expandState = node.expandState.load(std::memory_order_acquire);
+            if (expandState == 0 && node.visits.load(std::memory_order_relaxed) >= EXPAND_VISITS)
+            {
+                Expand(tree, index, state); // 2. 展开
+                expandState = node.expandState.load(std::memory_order_acquire);
+            }
+            if (expandState != 2)
+                break;
+
+            int child = SelectChild(tree, index);
+            tree.nodes[child].visits.fetch_add(1, std::memory_order_relaxed);
+            path[depth] = child;
+            movers[depth] = state.turn;
+            depth++;
+            ApplyMove(state, tree.nodes[child].move);
+            index = child;
+        }
+
+        // 3. 模拟
+        int winner = Winner(state);
+        if (winner < 0)
+            winner = Playout(state, rng);
+
+        // 4. 回传：访问次数在选择时已经加过，这里只加胜场
+        for (int k = 0; k < depth; k++)
+        {
+            if (movers[k] == winner)
+                tree.nodes[path[k]].wins.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+MctsResult MctsSearch(const GameState &state, const MctsLimits &limits, MctsTree &tree)
+{
+    MctsResult result = {};
+    auto start = std::chrono::steady_clock::now();
+
+    GameState root = state;
+    tree.used.store(1);
+    ResetNode(tree.nodes[0], Move{});
+    Expand(tree, 0, root);
+    if (tree.nodes[0].expandState.load() != 2)
+        return result; // 无棋可走
+
+    MctsShared shared;
+    shared.tree = &tree;
+    shared.root = &root;
+    shared.limits = limits;
+    shared.start = start;
+    shared.playouts.store(0);
+    shared.stop.store(limits.playouts <= 0 && limits.timeMs <= 0); // 两个预算都没给就不搜
+
+    int threadCount = limits.threads > 1 ? limits.threads : 1;
+    std::vector<std::thread> workers;
+    for (int k = 1; k < threadCount; k++)
+        workers.emplace_back(MctsWorker, &shared, k);
+    MctsWorker(&shared, 0);
+    for (auto &worker : workers)
+        worker.join();
+
+    // 访问次数最多的着法最可靠
+    const MctsNode &rootNode = tree.nodes[0];
+    int best = rootNode.firstChild;
+    for (int k = rootNode.firstChild; k < rootNode.firstChild + rootNode.childCount; k++)
+    {
+        if (tree.nodes[k].visits.load() > tree.nodes[best].visits.load())
+            best = k;
+    }
+
+    int visits = tree.nodes[best].visits.load();
+    result.best = tree.nodes[best].move;
+    result.winRate = visits > 0 ? (double)tree.nodes[best].wins.load() / visits : 0;
+    result.playouts = rootNode.visits.load();
+    result.treeNodes = tree.used.load() < (int)tree.nodes.size() ? tree.used.load() : (int)tree.nodes.size();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,339 @@
+#include "path.h"
+
+// 棋盘边界当作一直存在的墙，编译期算好
+struct EdgeTable
+{
+    uint8_t mask[CELL_COUNT];
+};
+
+static constexpr EdgeTable MakeEdgeTable()
+{
+    EdgeTable table = {};
+    for (int x = 0; x < BOARD_SIZE; x++)
+    {
+        for (int y = 0; y < BOARD_SIZE; y++)
+        {
+            uint8_t mask = 0;
+            if (y == 0)
+                mask |= BLOCK_UP;
+            if (y == BOARD_SIZE - 1)
+                mask |= BLOCK_DOWN;
+            if (x == 0)
+                mask |= BLOCK_LEFT;
+            if (x == BOARD_SIZE - 1)
+                mask |= BLOCK_RIGHT;
+            table.mask[CellIndex(x, y)] = mask;
+        }
+    }
+    return table;
+}
+
+static constexpr EdgeTable edgeBlocked = MakeEdgeTable();
+
+// BLOCK_UP / DOWN / LEFT / RIGHT 对应的下标偏移
+static const int cellStep[4] = {-1, 1, -BOARD_SIZE, BOARD_SIZE};
+
+int OpenDirections(const BitBoard &board, int cell)
+{
+    return ~(board.blocked[cell] | edgeBlocked.mask[cell]) & 0x0F;
+}
+
+bool HasPathToGoal(const BitBoard &board, int x, int y, int targetX)
+{
+    if (x == targetX)
+        return true;
+
+    // 每个格子最多入队一次，81 格的环形队列永远不会溢出
+    uint8_t queue[CELL_COUNT];
+    int head = 0, tail = 0;
+
+    CellMask visited = {0, 0};
+
+    int start = CellIndex(x, y);
+    queue[tail] = start;
+    tail = (tail + 1) % CELL_COUNT;
+    SetCell(visited, start);
+
+    // 目标列的格子下标是连续的：targetX * 9 ~ targetX * 9 + 8
+    int goalFirst = CellIndex(targetX, 0);
+    int goalLast = CellIndex(targetX, BOARD_SIZE - 1);
+
+    while (head != tail)
+    {
+        int cell = queue[head];
+        head = (head + 1) % CELL_COUNT;
+
+        int open = OpenDirections(board, cell);
+        for (int d = 0; d < 4; d++)
+        {
+            if (!(open & (1 << d)))
+                continue;
+
+            int next = cell + cellStep[d];
+            if (TestCell(visited, next))
+                continue;
+
+            if (next >= goalFirst && next <= goalLast)
+                return true; // 到达目标列
+
+            SetCell(visited, next);
+            queue[tail] = next;
+            tail = (tail + 1) % CELL_COUNT;
+        }
+    }
+
+    return false; // 路径被阻断
+}
+
+// ------------------------------距离场------------------------------
+
+DistanceField NewDistanceField(const BitBoard &board, int targetX)
+{
+    DistanceField field;
+    field.targetX = targetX;
+    for (int i = 0; i < CELL_COUNT; i++)
+        field.dist[i] = UNREACHABLE;
+
+    uint8_t queue[CELL_COUNT];
+    int head = 0, tail = 0;
+
+    // 目标列的格子全部是起点
+    for (int y = 0; y < BOARD_SIZE; y++)
+    {
+        int cell = CellIndex(targetX, y);
+        field.dist[cell] = 0;
+        queue[tail++] = cell;
+    }
+
+    while (head != tail)
+    {
+        int cell = queue[head++];
+        int open = OpenDirections(board, cell);
+        for (int d = 0; d < 4; d++)
+        {
+            int next = cell + cellStep[d];
+            if ((open & (1 << d)) && field.dist[next] == UNREACHABLE)
+            {
+                field.dist[next] = field.dist[cell] + 1;
+                queue[tail++] = next;
+            }
+        }
+    }
+    return field;
+}
+
+// 一面墙切断的两条边：from 格子往 dir 方向（dir 是 BLOCK_* 的位序号）
+static bool WallCutEdges(int x, int y, bool horizontal, int from[2], int dir[2])
+{
+    int i, j;
+    if (!WallToSlot(x, y, horizontal, i, j))
+        return false;
+
+    if (horizontal)
+    {
+        from[0] = CellIndex(i, j);
+        from[1] = CellIndex(i + 1, j);
+        dir[0] = dir[1] = 1; // BLOCK_DOWN
+    }
+    else
+    {
+        from[0] = CellIndex(i, j);
+        from[1] = CellIndex(i, j + 1);
+        dir[0] = dir[1] = 3; // BLOCK_RIGHT
+    }
+    return true;
+}
+
+// 格子在 board 上还有没有一个距离少 1、而且没被作废的邻居（最短路树里的父节点）
+static bool HasParent(const BitBoard &board, const DistanceField &field, int cell, const CellMask &invalid)
+{
+    int open = OpenDirections(board, cell);
+    for (int d = 0; d < 4; d++)
+    {
+        if (!(open & (1 << d)))
+            continue;
+        int next = cell + cellStep[d];
+        if (field.dist[next] + 1 == field.dist[cell] && !TestCell(invalid, next))
+            return true;
+    }
+    return false;
+}
+
+// 被切断的边上距离较大的那一端（它可能失去父节点），没有则返回 -1
+static int CutEdgeChild(const DistanceField &field, int from, int dir)
+{
+    int to = from + cellStep[dir];
+    uint8_t a = field.dist[from], b = field.dist[to];
+    if (a == UNREACHABLE || b == UNREACHABLE || a == b)
+        return -1;
+    return a > b ? from : to;
+}
+
+bool PathSurvivesWall(const BitBoard &board, const DistanceField &field, int px, int py, int x, int y, bool horizontal)
+{
+    int from[2], dir[2];
+    int start = CellIndex(px, py);
+    if (field.dist[start] == UNREACHABLE)
+        return false;
+    if (!WallCutEdges(x, y, horizontal, from, dir))
+        return true; // 不是合法墙槽，什么也挡不住
+
+    // 常见情况：沿距离场走一条最短路，这面墙没切到这条路就一定还能到达终点
+    bool cut = false;
+    int cell = start;
+    while (field.dist[cell] > 0 && !cut)
+    {
+        int open = OpenDirections(board, cell);
+        for (int d = 0; d < 4; d++)
+        {
+            int next = cell + cellStep[d];
+            if ((open & (1 << d)) && field.dist[next] + 1 == field.dist[cell])
+            {
+                for (int e = 0; e < 2; e++)
+                {
+                    int to = from[e] + cellStep[dir[e]];
+                    if ((cell == from[e] && next == to) || (cell == to && next == from[e]))
+                        cut = true;
+                }
+                cell = next;
+                break;
+            }
+        }
+    }
+    if (!cut)
+        return true;
+
+    BitBoard after = board;
+    PlaceWall(after, x, y, horizontal);
+    return HasPathToGoal(after, px, py, field.targetX);
+}
+
+// 按距离分桶的队列（距离 0 ~ 81），全部在栈上
+struct BucketQueue
+{
+    int head[CELL_COUNT + 1];
+    int next[CELL_COUNT * 5];
+    uint8_t cell[CELL_COUNT * 5];
+    int size;
+};
+
+static void BucketInit(BucketQueue &q)
+{
+    for (int d = 0; d <= CELL_COUNT; d++)
+        q.head[d] = -1;
+    q.size = 0;
+}
+
+static void BucketPush(BucketQueue &q, int d, int cell)
+{
+    q.cell[q.size] = cell;
+    q.next[q.size] = q.head[d];
+    q.head[d] = q.size++;
+}
+
+static int BucketPop(BucketQueue &q, int d)
+{
+    int e = q.head[d];
+    if (e < 0)
+        return -1;
+    q.head[d] = q.next[e];
+    return q.cell[e];
+}
+
+void UpdateDistanceField(const BitBoard &board, int x, int y, bool horizontal, DistanceField &field)
+{
+    int from[2], dir[2];
+    if (!WallCutEdges(x, y, horizontal, from, dir))
+        return;
+
+    // 1. 从被切断的边开始，按距离从小到大找出失去所有父节点的格子（它们的子孙也要跟着检查）
+    BucketQueue q;
+    BucketInit(q);
+    CellMask queued = {0, 0};
+    CellMask invalid = {0, 0};
+    uint8_t invalidCells[CELL_COUNT];
+    int invalidCount = 0;
+
+    for (int e = 0; e < 2; e++)
+    {
+        int child = CutEdgeChild(field, from[e], dir[e]);
+        if (child >= 0 && !TestCell(queued, child))
+        {
+            SetCell(queued, child);
+            BucketPush(q, field.dist[child], child);
+        }
+    }
+
+    for (int d = 0; d < CELL_COUNT; d++)
+    {
+        int cell;
+        while ((cell = BucketPop(q, d)) >= 0)
+        {
+            if (HasParent(board, field, cell, invalid))
+                continue;
+
+            SetCell(invalid, cell);
+            invalidCells[invalidCount++] = cell;
+
+            int open = OpenDirections(board, cell);
+            for (int k = 0; k < 4; k++)
+            {
+                int next = cell + cellStep[k];
+                if ((open & (1 << k)) && field.dist[next] == d + 1 && !TestCell(queued, next))
+                {
+                    SetCell(queued, next);
+                    BucketPush(q, d + 1, next);
+                }
+            }
+        }
+    }
+
+    if (invalidCount == 0)
+        return; // 最短路树没被切断，距离场不变
+
+    // 2. 只在作废的区域里重算：先用区域边界上的有效邻居当起点，再按距离扩散
+    for (int k = 0; k < invalidCount; k++)
+        field.dist[invalidCells[k]] = UNREACHABLE;
+
+    BucketInit(q);
+    for (int k = 0; k < invalidCount; k++)
+    {
+        int cell = invalidCells[k];
+        int open = OpenDirections(board, cell);
+        int best = UNREACHABLE;
+        for (int d = 0; d < 4; d++)
+        {
+            int next = cell + cellStep[d];
+            if ((open & (1 << d)) && !TestCell(invalid, next) && field.dist[next] != UNREACHABLE && field.dist[next] + 1 < best)
+                best = field.dist[next] + 1;
+        }
+        if (best != UNREACHABLE)
+        {
+            field.dist[cell] = best;
+            BucketPush(q, best, cell);
+        }
+    }
+
+    CellMask done = {0, 0};
+    for (int d = 0; d < CELL_COUNT; d++)
+    {
+        int cell;
+        while ((cell = BucketPop(q, d)) >= 0)
+        {
+            if (TestCell(done, cell) || field.dist[cell] != d)
+                continue; // 已经用更短的距离处理过
+            SetCell(done, cell);
+
+            int open = OpenDirections(board, cell);
+            for (int k = 0; k < 4; k++)
+            {
+                int next = cell + cellStep[k];
+                if ((open & (1 << k)) && TestCell(invalid, next) && !TestCell(done, next) && d + 1 < field.dist[next])
+                {
+                    field.dist[next] = d + 1;
+                    BucketPush(q, d + 1, next);
+                }
+            }
+        }
+    }
+}
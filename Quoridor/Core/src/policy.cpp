@@ -0,0 +1,197 @@
+#include "policy.h"
+#include <cstdlib>
+#include <cstring>
+
+const int POLICY_TT_MB = 16;            // 每个线程的置换表大小
+const int POLICY_MCTS_NODES = 1 << 18;  // 每个线程的 MCTS 节点池
+const int DEFAULT_SEARCH_DEPTH = 2;     // "search" 不带深度时
+const int DEFAULT_MCTS_PLAYOUTS = 1000; // "mcts" 不带模拟次数时
+
+static uint32_t NextRandom(uint64_t &state) // xorshift64*
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (uint32_t)((state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+bool ParsePolicy(const char *text, PolicyConfig &config)
+{
+    config = {};
+    const char *colon = strchr(text, ':');
+    size_t nameLength = colon ? (size_t)(colon - text) : strlen(text);
+    int argument = colon ? atoi(colon + 1) : 0;
+
+    if (nameLength == 6 && strncmp(text, "random", 6) == 0)
+        config.type = POLICY_RANDOM;
+    else if (nameLength == 6 && strncmp(text, "greedy", 6) == 0)
+        config.type = POLICY_GREEDY;
+    else if (nameLength == 6 && strncmp(text, "search", 6) == 0)
+    {
+        config.type = POLICY_SEARCH;
+        config.depth = argument > 0 ? argument : DEFAULT_SEARCH_DEPTH;
+    }
+    else if (nameLength == 4 && strncmp(text, "mcts", 4) == 0)
+    {
+        config.type = POLICY_MCTS;
+        config.playouts = argument > 0 ? argument : DEFAULT_MCTS_PLAYOUTS;
+    }
+    else
+        return false;
+    return true;
+}
+
+static uint64_t SeedRandom(uint64_t seed)
+{
+    return seed * 0x9E3779B97F4A7C15ULL + 1; // xorshift 的状态不能是 0
+}
+
+void InitPolicyWorker(PolicyWorker &worker, uint64_t seed)
+{
+    worker.rng = SeedRandom(seed);
+    worker.ttReady = false;
+    worker.treeReady = false;
+}
+
+// ------------------------------策略------------------------------
+
+static Move RandomMove(GameState &state, uint64_t &rng)
+{
+    Move moves[MAX_MOVES];
+    int count = GenerateMoves(state, moves);
+    if (count == 0)
+        return Move{};
+    return moves[NextRandom(rng) % count];
+}
+
+// 沿最短路走一步，距离相同的格子随机挑
+static Move ShortestPathMove(const GameState &state, uint64_t &rng)
+{
+    int me = state.turn;
+    uint8_t cells[MAX_PAWN_MOVES];
+    int count = PawnMoves(state.board, state.x[me], state.y[me], state.x[1 - me], state.y[1 - me], cells);
+    if (count == 0)
+        return Move{};
+
+    int best = 0, ties = 0;
+    for (int k = 0; k < count; k++)
+    {
+        int distance = state.field[me].dist[cells[k]];
+        if (k == 0 || distance < state.field[me].dist[cells[best]])
+        {
+            best = k;
+            ties = 1;
+        }
+        else if (distance == state.field[me].dist[cells[best]] && NextRandom(rng) % ++ties == 0)
+            best = k;
+    }
+    return Move{(uint8_t)MOVE_PAWN, (int8_t)(cells[best] / BOARD_SIZE), (int8_t)(cells[best] % BOARD_SIZE), false};
+}
+
+// 贪心：自己先走，步数不多于对手就赢；落后时在对手最短路上找一面
+// “对手多走的步数 - 自己多走的步数”最大的墙，找不到有用的墙就照常走
+static Move GreedyMove(GameState &state, uint64_t &rng)
+{
+    int me = state.turn, opponent = 1 - me;
+    int myCell = CellIndex(state.x[me], state.y[me]);
+    int opponentCell = CellIndex(state.x[opponent], state.y[opponent]);
+    int myDistance = state.field[me].dist[myCell];
+    int opponentDistance = state.field[opponent].dist[opponentCell];
+
+    if (state.wallsLeft[me] > 0 && opponentDistance < myDistance)
+    {
+        uint64_t cutH, cutV;
+        ShortestPathSlots(state.board, state.field[opponent], state.x[opponent], state.y[opponent], cutH, cutV);
+
+        Move best = {};
+        int bestGain = 0, ties = 0;
+        for (int o = 0; o < 2; o++)
+        {
+            uint64_t slots = o == 0 ? cutH : cutV;
+            while (slots)
+            {
+                int bit = __builtin_ctzll(slots);
+                slots &= slots - 1;
+                int i = bit / WALL_GRID, j = bit % WALL_GRID;
+                Move wall = o == 0 ? Move{(uint8_t)MOVE_WALL, (int8_t)i, (int8_t)(j + 1), true}
+                                   : Move{(uint8_t)MOVE_WALL, (int8_t)(i + 1), (int8_t)j, false};
+                if (!IsMoveLegal(state, wall))
+                    continue;
+
+                BitBoard board = state.board;
+                PlaceWall(board, wall.x, wall.y, wall.horizontal);
+                DistanceField opponentField = state.field[opponent];
+                DistanceField myField = state.field[me];
+                UpdateDistanceField(board, wall.x, wall.y, wall.horizontal, opponentField);
+                UpdateDistanceField(board, wall.x, wall.y, wall.horizontal, myField);
+                int gain = (opponentField.dist[opponentCell] - opponentDistance) - (myField.dist[myCell] - myDistance);
+                if (gain > bestGain)
+                {
+                    best = wall;
+                    bestGain = gain;
+                    ties = 1;
+                }
+                else if (gain == bestGain && gain > 0 && NextRandom(rng) % ++ties == 0)
+                    best = wall;
+            }
+        }
+        if (bestGain > 0)
+            return best;
+    }
+    return ShortestPathMove(state, rng);
+}
+
+Move ChooseMove(const PolicyConfig &config, PolicyWorker &worker, GameState &state)
+{
+    switch (config.type)
+    {
+    case POLICY_GREEDY:
+        return GreedyMove(state, worker.rng);
+    case POLICY_SEARCH:
+        if (!worker.ttReady)
+        {
+            InitTranspositionTable(worker.tt, POLICY_TT_MB);
+            worker.ttReady = true;
+        }
+        return SearchBestMove(state, {config.depth, config.timeMs, 1}, worker.tt).best;
+    case POLICY_MCTS:
+        if (!worker.treeReady)
+        {
+            InitMctsTree(worker.tree, POLICY_MCTS_NODES);
+            worker.treeReady = true;
+        }
+        return MctsSearch(state, {config.playouts, config.timeMs, 1}, worker.tree).best;
+    default:
+        return RandomMove(state, worker.rng);
+    }
+}
+
+// ------------------------------对局------------------------------
+
+void PlayGame(const PolicyConfig players[2], PolicyWorker &worker, uint64_t seed, GameRecord &record)
+{
+    worker.rng = SeedRandom(seed);
+    if (worker.ttReady)
+        ClearTranspositionTable(worker.tt); // 上一局留下的条目会影响搜索结果
+
+    GameState state;
+    NewGame(state);
+    record.winner = -1;
+    record.plies = 0;
+    while (record.plies < MAX_GAME_PLIES)
+    {
+        Move move = ChooseMove(players[state.turn], worker, state);
+        if (move.type == 0)
+        {
+            record.winner = 1 - state.turn; // 无棋可走，算输
+            break;
+        }
+        record.moves[record.plies++] = move;
+        ApplyMove(state, move);
+        if (Winner(state) >= 0)
+        {
+            record.winner = Winner(state);
+            break;
+        }
+    }
+}
@@ -0,0 +1,326 @@
+#include "search.h"
+#include <chrono>
+#include <thread>
+
+const uint8_t BOUND_EXACT = 0;
+const uint8_t BOUND_LOWER = 1; // 分数 >= score（beta 截断）
+const uint8_t BOUND_UPPER = 2; // 分数 <= score（没有着法超过 alpha）
+
+// ------------------------------置换表------------------------------
+
+void InitTranspositionTable(TranspositionTable &tt, int megabytes)
+{
+    size_t count = 1;
+    while (count * 2 * sizeof(TTEntry) <= (size_t)megabytes * 1024 * 1024)
+        count *= 2;
+    tt.entries = std::vector<TTEntry>(count);
+    tt.mask = count - 1;
+    ClearTranspositionTable(tt);
+}
+
+void ClearTranspositionTable(TranspositionTable &tt)
+{
+    for (auto &entry : tt.entries)
+    {
+        entry.check.store(0, std::memory_order_relaxed);
+        entry.data.store(0, std::memory_order_relaxed);
+    }
+}
+
+struct TTData // 解包后的条目
+{
+    int score;
+    int depth;
+    uint8_t bound;
+    Move best;
+};
+
+// 分数 16 位 | 深度 8 位 | 边界 8 位 | 着法 32 位（type、x、y、horizontal 各 8 位）
+static uint64_t PackTT(int score, int depth, uint8_t bound, const Move &best)
+{
+    return (uint64_t)(uint16_t)score | (uint64_t)(uint8_t)depth << 16 | (uint64_t)bound << 24 |
+           (uint64_t)best.type << 32 | (uint64_t)(uint8_t)best.x << 40 | (uint64_t)(uint8_t)best.y << 48 | (uint64_t)best.horizontal << 56;
+}
+
+static TTData UnpackTT(uint64_t data)
+{
+    TTData d;
+    d.score = (int16_t)(data & 0xFFFF);
+    d.depth = (int8_t)((data >> 16) & 0xFF);
+    d.bound = (data >> 24) & 0xFF;
+    d.best.type = (data >> 32) & 0xFF;
+    d.best.x = (int8_t)((data >> 40) & 0xFF);
+    d.best.y = (int8_t)((data >> 48) & 0xFF);
+    d.best.horizontal = (data >> 56) & 0xFF;
+    return d;
+}
+
+static bool ProbeTT(const TranspositionTable &tt, uint64_t hash, TTData &out)
+{
+    const TTEntry &entry = tt.entries[hash & tt.mask];
+    uint64_t data = entry.data.load(std::memory_order_relaxed);
+    uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != hash)
+        return false; // 没命中，或者正好被别的线程写了一半
+    out = UnpackTT(data);
+    return true;
+}
+
+static void StoreTT(TranspositionTable &tt, uint64_t hash, int score, int depth, uint8_t bound, const Move &best)
+{
+    TTEntry &entry = tt.entries[hash & tt.mask];
+    uint64_t data = PackTT(score, depth, bound, best);
+    entry.data.store(data, std::memory_order_relaxed);
+    entry.check.store(hash ^ data, std::memory_order_relaxed);
+}
+
+// 获胜分数存进表里时换成“离当前节点还有几步”，取出来再换回“离根几步”
+static int ScoreToTT(int score, int ply)
+{
+    if (score > SCORE_WIN - 1000)
+        return score + ply;
+    if (score < -SCORE_WIN + 1000)
+        return score - ply;
+    return score;
+}
+
+static int ScoreFromTT(int score, int ply)
+{
+    if (score > SCORE_WIN - 1000)
+        return score - ply;
+    if (score < -SCORE_WIN + 1000)
+        return score + ply;
+    return score;
+}
+
+// ------------------------------评估------------------------------
+
+int Evaluate(const GameState &state)
+{
+    int me = state.turn, opponent = 1 - me;
+    int myDistance = state.field[me].dist[CellIndex(state.x[me], state.y[me])];
+    int opponentDistance = state.field[opponent].dist[CellIndex(state.x[opponent], state.y[opponent])];
+    return 10 * (opponentDistance - myDistance) + 3 * (state.wallsLeft[me] - state.wallsLeft[opponent]);
+}
+
+// ------------------------------搜索------------------------------
+
+struct SearchShared // 所有搜索线程共用
+{
+    TranspositionTable *tt;
+    std::chrono::steady_clock::time_point start;
+    int timeMs;
+    std::atomic<bool> stop; // 时间用完或主线程已经搜完，正在搜的那一层作废
+};
+
+struct alignas(64) SearchContext // 每个线程一份，按缓存行对齐避免互相干扰
+{
+    SearchShared *shared;
+    bool isMain;                   // 只有主线程看时间、给出结果
+    long long nodes;               // 本线程的节点数
+    std::atomic<long long> posted; // 定期公布给主线程统计的节点数
+};
+
+static bool SameMove(const Move &a, const Move &b)
+{
+    return a.type == b.type && a.x == b.x && a.y == b.y && (a.type == MOVE_PAWN || a.horizontal == b.horizontal);
+}
+
+static void CheckTime(SearchShared &shared)
+{
+    if (shared.timeMs <= 0)
+        return;
+    auto elapsed = std::chrono::steady_clock::now() - shared.start;
+    if (std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= shared.timeMs)
+        shared.stop.store(true, std::memory_order_relaxed);
+}
+
+// 着法排序：置换表着法 > 走棋（离终点越近越先） > 切断对手最短路的墙 > 其他墙
+static void OrderMoves(GameState &state, Move moves[], int count, const Move *ttMove)
+{
+    int me = state.turn, opponent = 1 - me;
+    uint64_t cutH, cutV;
+    ShortestPathSlots(state.board, state.field[opponent], state.x[opponent], state.y[opponent], cutH, cutV);
+
+    int keys[MAX_MOVES];
+    for (int k = 0; k < count; k++)
+    {
+        const Move &m = moves[k];
+        if (ttMove && SameMove(m, *ttMove))
+            keys[k] = -1000;
+        else if (m.type == MOVE_PAWN)
+            keys[k] = -100 + state.field[me].dist[CellIndex(m.x, m.y)];
+        else
+        {
+            int i, j;
+            WallToSlot(m.x, m.y, m.horizontal, i, j);
+            bool cuts = ((m.horizontal ? cutH : cutV) >> SlotBit(i, j)) & 1;
+            keys[k] = cuts ? 0 : 100;
+        }
+    }
+
+    // 插入排序，保持同分着法的原有顺序
+    for (int a = 1; a < count; a++)
+    {
+        Move m = moves[a];
+        int key = keys[a];
+        int b = a - 1;
+        while (b >= 0 && keys[b] > key)
+        {
+            moves[b + 1] = moves[b];
+            keys[b + 1] = keys[b];
+            b--;
+        }
+        moves[b + 1] = m;
+        keys[b + 1] = key;
+    }
+}
+
+static int Negamax(SearchContext &ctx, GameState &state, int depth, int alpha, int beta, int ply, Move *bestOut)
+{
+    if ((++ctx.nodes & 2047) == 0)
+    {
+        ctx.posted.store(ctx.nodes, std::memory_order_relaxed);
+        if (ctx.isMain)
+            CheckTime(*ctx.shared);
+    }
+    if (ctx.shared->stop.load(std::memory_order_relaxed))
+        return 0;
+
+    int winner = Winner(state);
+    if (winner >= 0)
+        return winner == state.turn ? SCORE_WIN - ply : -(SCORE_WIN - ply); // 上一步的人刚赢
+    if (depth == 0)
+        return Evaluate(state);
+
+    // 查置换表
+    TTData entry;
+    const Move *ttMove = nullptr;
+    if (ProbeTT(*ctx.shared->tt, state.hash, entry))
+    {
+        ttMove = &entry.best;
+        if (entry.depth >= depth && ply > 0)
+        {
+            int score = ScoreFromTT(entry.score, ply);
+            if (entry.bound == BOUND_EXACT ||
+                (entry.bound == BOUND_LOWER && score >= beta) ||
+                (entry.bound == BOUND_UPPER && score <= alpha))
+                return score;
+        }
+    }
+
+    Move moves[MAX_MOVES];
+    int count = GenerateMoves(state, moves);
+    if (count == 0)
+        return Evaluate(state); // 被围住无棋可走（规则上很少见），按静态评估处理
+    OrderMoves(state, moves, count, ttMove);
+
+    int alphaStart = alpha;
+    int bestScore = -SCORE_WIN - 1;
+    Move best = moves[0];
+    for (int k = 0; k < count; k++)
+    {
+        GameState child = state;
+        ApplyMove(child, moves[k]);
+        int score = -Negamax(ctx, child, depth - 1, -beta, -alpha, ply + 1, nullptr);
+        if (ctx.shared->stop.load(std::memory_order_relaxed))
+            return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = moves[k];
+        }
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta)
+            break; // beta 截断
+    }
+
+    // 写回置换表（总是替换）
+    uint8_t bound = bestScore >= beta ? BOUND_LOWER : (bestScore <= alphaStart ? BOUND_UPPER : BOUND_EXACT);
+    StoreTT(*ctx.shared->tt, state.hash, ScoreToTT(bestScore, ply), depth, bound, best);
+
+    if (bestOut)
+        *bestOut = best;
+    return bestScore;
+}
+
+// 辅助线程：和主线程搜同一个局面，奇数号线程从深一层开始，让各线程错开，把结果留在置换表里
+static void HelperSearch(SearchContext *ctx, GameState root, int maxDepth, int id)
+{
+    for (int depth = 1 + (id & 1); depth <= maxDepth; depth++)
+    {
+        Move best;
+        Negamax(*ctx, root, depth, -SCORE_WIN - 1, SCORE_WIN + 1, 0, &best);
+        if (ctx->shared->stop.load(std::memory_order_relaxed))
+            break;
+    }
+    ctx->posted.store(ctx->nodes, std::memory_order_relaxed);
+}
+
+static long long TotalNodes(const std::vector<SearchContext> &contexts)
+{
+    long long total = contexts[0].nodes;
+    for (size_t k = 1; k < contexts.size(); k++)
+        total += contexts[k].posted.load(std::memory_order_relaxed);
+    return total;
+}
+
+SearchResult SearchBestMove(const GameState &state, const SearchLimits &limits, TranspositionTable &tt)
+{
+    SearchResult result = {};
+    SearchShared shared;
+    shared.tt = &tt;
+    shared.start = std::chrono::steady_clock::now();
+    shared.timeMs = limits.timeMs;
+    shared.stop.store(false);
+
+    GameState root = state;
+    Move fallback[MAX_MOVES];
+    if (GenerateMoves(root, fallback) == 0)
+        return result;
+    result.best = fallback[0]; // 连第 1 层都没搜完时至少有一步能走
+
+    int maxDepth = limits.maxDepth < MAX_SEARCH_DEPTH ? limits.maxDepth : MAX_SEARCH_DEPTH;
+    int threadCount = limits.threads > 1 ? limits.threads : 1;
+    std::vector<SearchContext> contexts(threadCount);
+    for (int k = 0; k < threadCount; k++)
+    {
+        contexts[k].shared = &shared;
+        contexts[k].isMain = k == 0;
+        contexts[k].nodes = 0;
+        contexts[k].posted.store(0);
+    }
+
+    std::vector<std::thread> helpers;
+    for (int k = 1; k < threadCount; k++)
+        helpers.emplace_back(HelperSearch, &contexts[k], root, maxDepth, k);
+
+    SearchContext &ctx = contexts[0];
+    for (int depth = 1; depth <= maxDepth; depth++)
+    {
+        Move best;
+        int score = Negamax(ctx, root, depth, -SCORE_WIN - 1, SCORE_WIN + 1, 0, &best);
+        if (shared.stop.load())
+            break; // 这一层没搜完，用上一层的结果
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - shared.start).count();
+        result.best = best;
+        result.score = score;
+        result.depth = depth;
+        result.depthNodes[depth] = TotalNodes(contexts);
+        result.depthSeconds[depth] = seconds;
+
+        if (score > SCORE_WIN - 1000 || score < -SCORE_WIN + 1000)
+            break; // 已经算出胜负
+    }
+
+    shared.stop.store(true);
+    for (auto &helper : helpers)
+        helper.join();
+
+    result.nodes = TotalNodes(contexts);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - shared.start).count();
+    return result;
+}
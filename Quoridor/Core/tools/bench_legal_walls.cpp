@@ -0,0 +1,246 @@
+// 合法墙槽集合微基准：把 128 个墙槽全部判断一遍要多久
+//   旧版逐槽检查：IsWallValid（遍历 std::vector<Wall>）+ 两个玩家各一次 push + BFS + pop
+//   现版逐槽检查：CanPlaceWall（掩码 AND）+ 两次 PathSurvivesWall（距离场缓存）
+//   LegalWallSet ：重叠用位运算一次算完，只对切到最短路的空槽跑 BFS；玩家移动后只重算他自己
+// 另外量一下鼠标停在一个墙槽上时，预览每帧要花多少：旧版每帧 push + 两次 BFS + pop，现版每帧查一个位
+//
+// 编译（在 Quoridor/Core 目录下）：
+//   g++ -O2 -std=c++17 -Iinclude src/*.cpp tools/bench_legal_walls.cpp -o bench_legal_walls
+// 运行：
+//   ./bench_legal_walls [局面数量]
+
+#include "board.h"
+#include "path.h"
+#include "legal_walls.h"
+#include "legacy_rules.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+// ------------------------------测试局面------------------------------
+
+struct Position
+{
+    vector<Wall> walls;
+    BitBoard board;
+    int px[2], py[2];
+    DistanceField field[2];
+    LegalWallSet set;
+    int mover; // 最后一步走棋的玩家（增量更新只重算他）
+};
+
+// 随机对局：每一步要么随机走一格，要么随机放一面合法的墙
+static vector<Position> MakePositions(int count, unsigned seed)
+{
+    mt19937 rng(seed);
+    vector<Position> positions(count);
+    for (auto &pos : positions)
+    {
+        pos.board = {};
+        pos.px[0] = 0, pos.py[0] = 4;
+        pos.px[1] = BOARD_SIZE - 1, pos.py[1] = 4;
+        pos.field[0] = NewDistanceField(pos.board, BOARD_SIZE - 1);
+        pos.field[1] = NewDistanceField(pos.board, 0);
+        pos.set = NewLegalWallSet(pos.board, pos.px[0], pos.py[0], pos.field[0], pos.px[1], pos.py[1], pos.field[1]);
+        pos.mover = 0;
+
+        int plies = rng() % 41;
+        for (int ply = 0; ply < plies; ply++)
+        {
+            int k = ply & 1;
+            if ((int)pos.walls.size() < 20 && rng() % 3 == 0 && CountLegalWalls(pos.set) > 0)
+            {
+                Wall w;
+                do
+                {
+                    w = {int(rng() % BOARD_SIZE), int(rng() % BOARD_SIZE), bool(rng() & 1), k + 1};
+                } while (!IsWallLegal(pos.set, w.x, w.y, w.horizontal));
+                pos.walls.push_back(w);
+                PlaceWall(pos.board, w.x, w.y, w.horizontal);
+                for (int p = 0; p < 2; p++)
+                    UpdateDistanceField(pos.board, w.x, w.y, w.horizontal, pos.field[p]);
+                for (int p = 0; p < 2; p++)
+                    UpdateLegalWalls(pos.set, pos.board, p, pos.px[p], pos.py[p], pos.field[p]);
+            }
+            else
+            {
+                int open = OpenDirections(pos.board, CellIndex(pos.px[k], pos.py[k]));
+                const int dx[4] = {0, 0, -1, 1};
+                const int dy[4] = {-1, 1, 0, 0};
+                int d = rng() % 4;
+                int nx = pos.px[k] + dx[d], ny = pos.py[k] + dy[d];
+                if (!(open & (1 << d)) || (nx == pos.px[1 - k] && ny == pos.py[1 - k]))
+                    continue;
+                pos.px[k] = nx;
+                pos.py[k] = ny;
+                UpdateLegalWalls(pos.set, pos.board, k, pos.px[k], pos.py[k], pos.field[k]);
+                pos.mover = k;
+            }
+        }
+    }
+    return positions;
+}
+
+// 现版逐槽检查一个墙槽
+static bool SlotLegal(const Position &pos, int x, int y, bool horizontal)
+{
+    if (!CanPlaceWall(pos.board, x, y, horizontal))
+        return false;
+    return PathSurvivesWall(pos.board, pos.field[0], pos.px[0], pos.py[0], x, y, horizontal) &&
+           PathSurvivesWall(pos.board, pos.field[1], pos.px[1], pos.py[1], x, y, horizontal);
+}
+
+// 旧版逐槽检查一个墙槽
+static bool LegacySlotLegal(Position &pos, const Wall &wall)
+{
+    if (!LegacyIsWallValid(wall, pos.walls))
+        return false;
+    pos.walls.push_back(wall);
+    bool blocked = LegacyIsPathBlockedForPlayer(pos.px[0], pos.py[0], BOARD_SIZE - 1, pos.walls) ||
+                   LegacyIsPathBlockedForPlayer(pos.px[1], pos.py[1], 0, pos.walls);
+    pos.walls.pop_back();
+    return !blocked;
+}
+
+// 128 个合法墙槽的游戏坐标
+static void SlotWall(int slot, Wall &wall)
+{
+    int bit = slot % 64;
+    int i = bit / WALL_GRID, j = bit % WALL_GRID;
+    if (slot < 64)
+        wall = {i, j + 1, true, 0};
+    else
+        wall = {i + 1, j, false, 0};
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 5000;
+    vector<Position> positions = MakePositions(count, 2025);
+
+    // 先确认三种写法结果一致，增量维护的集合也和从头建的一样
+    long long legalTotal = 0;
+    for (auto &pos : positions)
+    {
+        LegalWallSet fresh = NewLegalWallSet(pos.board, pos.px[0], pos.py[0], pos.field[0], pos.px[1], pos.py[1], pos.field[1]);
+        if (fresh.h != pos.set.h || fresh.v != pos.set.v)
+        {
+            printf("Incremental set differs from rebuilt set (%zu walls)\n", pos.walls.size());
+            return 1;
+        }
+        for (int slot = 0; slot < 128; slot++)
+        {
+            Wall w;
+            SlotWall(slot, w);
+            bool inSet = IsWallLegal(pos.set, w.x, w.y, w.horizontal);
+            if (inSet != SlotLegal(pos, w.x, w.y, w.horizontal) || inSet != LegacySlotLegal(pos, w))
+            {
+                printf("Mismatch at wall (%d, %d, %s) with %zu walls\n", w.x, w.y, w.horizontal ? "h" : "v", pos.walls.size());
+                return 1;
+            }
+        }
+        legalTotal += CountLegalWalls(pos.set);
+    }
+    printf("%d positions checked, %.1f legal slots on average, results identical\n\n", count, double(legalTotal) / count);
+
+    const int rounds = 5;
+    volatile long long sink = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (auto &pos : positions)
+        {
+            for (int slot = 0; slot < 128; slot++)
+            {
+                Wall w;
+                SlotWall(slot, w);
+                sink += LegacySlotLegal(pos, w);
+            }
+        }
+    }
+    double legacySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds * 10; r++)
+    {
+        for (const auto &pos : positions)
+        {
+            for (int slot = 0; slot < 128; slot++)
+            {
+                Wall w;
+                SlotWall(slot, w);
+                sink += SlotLegal(pos, w.x, w.y, w.horizontal);
+            }
+        }
+    }
+    double slotSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() / 10;
+
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds * 10; r++)
+    {
+        for (const auto &pos : positions)
+        {
+            LegalWallSet set = NewLegalWallSet(pos.board, pos.px[0], pos.py[0], pos.field[0], pos.px[1], pos.py[1], pos.field[1]);
+            sink += set.h ^ set.v;
+        }
+    }
+    double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() / 10;
+
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds * 10; r++)
+    {
+        for (auto &pos : positions)
+        {
+            int k = pos.mover;
+            UpdateLegalWalls(pos.set, pos.board, k, pos.px[k], pos.py[k], pos.field[k]);
+            sink += pos.set.h ^ pos.set.v;
+        }
+    }
+    double moveSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() / 10;
+
+    // 悬停预览：每个局面鼠标在同一个墙槽上停 HOVER_FRAMES 帧
+    const int HOVER_FRAMES = 60;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        Wall w;
+        SlotWall(i % 128, w);
+        for (int frame = 0; frame < HOVER_FRAMES; frame++)
+            sink += LegacySlotLegal(positions[i], w);
+    }
+    double legacyHoverSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds * 100; r++)
+    {
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            Wall w;
+            SlotWall(i % 128, w);
+            for (int frame = 0; frame < HOVER_FRAMES; frame++)
+                sink += IsWallLegal(positions[i].set, w.x, w.y, w.horizontal);
+        }
+    }
+    double hoverSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() / (rounds * 100);
+
+    double sets = double(rounds) * count;
+    printf("all 128 slots per position\n");
+    printf("%-34s %14s %12s\n", "", "sets/sec", "us/set");
+    printf("%-34s %14.0f %12.2f\n", "before (vector, per-slot BFS)", sets / legacySeconds, legacySeconds / sets * 1e6);
+    printf("%-34s %14.0f %12.2f\n", "per-slot (bitboard + dist cache)", sets / slotSeconds, slotSeconds / sets * 1e6);
+    printf("%-34s %14.0f %12.2f\n", "LegalWallSet full build", sets / buildSeconds, buildSeconds / sets * 1e6);
+    printf("%-34s %14.0f %12.2f\n", "LegalWallSet after a pawn move", sets / moveSeconds, moveSeconds / sets * 1e6);
+    printf("\nfull build vs per-slot: %.1fx, vs before: %.0fx\n", slotSeconds / buildSeconds, legacySeconds / buildSeconds);
+
+    double frames = double(HOVER_FRAMES) * count;
+    printf("\nwall preview while hovering one slot\n");
+    printf("%-34s %14s\n", "", "ns/frame");
+    printf("%-34s %14.1f\n", "before (push + 2 BFS + pop)", legacyHoverSeconds / frames * 1e9);
+    printf("%-34s %14.1f\n", "LegalWallSet bit lookup", hoverSeconds / frames * 1e9);
+    return 0;
+}
@@ -0,0 +1,49 @@
+// MCTS 基准：固定几个局面，用 1、2、4 ... 个线程（树并行 + 虚拟失败）各搜一段时间
+// 输出每秒模拟次数、用掉的树节点、选中的着法和它的模拟胜率
+//
+// 编译（在 Quoridor/Core 目录下）：
+//   g++ -O2 -std=c++17 -pthread -Iinclude src/*.cpp tools/bench_mcts.cpp -o bench_mcts
+// 运行：
+//   ./bench_mcts [每次搜索的时间预算 ms] [最多线程数] [模拟次数预算，0 = 只按时间]
+
+#include "bench_positions.h"
+#include "mcts.h"
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+int main(int argc, char **argv)
+{
+    int timeMs = argc > 1 ? atoi(argv[1]) : 1000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+    int playouts = argc > 3 ? atoi(argv[3]) : 0;
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    MctsTree tree;
+    InitMctsTree(tree, 1 << 21);
+
+    for (const auto &pos : positions)
+    {
+        GameState state;
+        if (!SetupBenchPosition(pos, state))
+            return 1;
+
+        printf("%s (%d ms budget)\n", pos.name, timeMs);
+        printf("  %7s %10s %14s %10s %10s  %s\n", "threads", "playouts", "playouts/sec", "speedup", "nodes", "best (win rate)");
+        double baseRate = 0;
+        for (int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            MctsResult result = MctsSearch(state, {playouts, timeMs, threads}, tree);
+            double rate = result.playouts / result.seconds;
+            if (threads == 1)
+                baseRate = rate;
+            printf("  %7d %10lld %14.0f %9.2fx %10d  %s (%d, %d)%s %.1f%%\n", threads, result.playouts, rate, rate / baseRate, result.treeNodes,
+                   result.best.type == MOVE_PAWN ? "move" : "wall", result.best.x, result.best.y,
+                   result.best.type == MOVE_WALL ? (result.best.horizontal ? " horizontal" : " vertical") : "",
+                   result.winRate * 100);
+        }
+        printf("\n");
+    }
+    return 0;
+}
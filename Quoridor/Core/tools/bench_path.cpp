@@ -0,0 +1,170 @@
+// 路径检查微基准：旧版 IsPathBlockedForPlayer（std::vector<Wall> + std::queue + std::unordered_set）
+// 对比新版 HasPathToGoal（位棋盘 + 栈上环形队列 + 128 位 visited），
+// 以及“放这面墙会不会封死路径”时先查距离场缓存的 PathSurvivesWall
+//
+// 编译（在 Quoridor/Core 目录下）：
+//   g++ -O2 -std=c++17 -Iinclude src/*.cpp tools/bench_path.cpp -o bench_path
+// 运行：
+//   ./bench_path [局面数量]
+
+#include "board.h"
+#include "path.h"
+#include "legacy_rules.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+// 统计堆分配次数
+static long long allocationCount = 0;
+
+void *operator new(size_t size)
+{
+    allocationCount++;
+    void *p = malloc(size);
+    if (!p)
+        throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// ------------------------------测试局面------------------------------
+
+struct Position
+{
+    vector<Wall> walls;
+    BitBoard board;
+    int px, py, targetX;
+    Wall candidate;      // 要检查的新墙
+    DistanceField field; // 游戏里随放墙增量维护，这里预先算好
+};
+
+static vector<Position> MakePositions(int count, unsigned seed)
+{
+    mt19937 rng(seed);
+    vector<Position> positions(count);
+    for (auto &pos : positions)
+    {
+        pos.board = {};
+        int wallCount = rng() % 21; // 0 ~ 20 面墙（双方各 10 面）
+        for (int attempts = 0; (int)pos.walls.size() < wallCount && attempts < 200; attempts++)
+        {
+            Wall w = {int(rng() % BOARD_SIZE), int(rng() % BOARD_SIZE), bool(rng() & 1), 0};
+            if (CanPlaceWall(pos.board, w.x, w.y, w.horizontal))
+            {
+                PlaceWall(pos.board, w.x, w.y, w.horizontal);
+                pos.walls.push_back(w);
+            }
+        }
+        pos.px = rng() % BOARD_SIZE;
+        pos.py = rng() % BOARD_SIZE;
+        pos.targetX = (rng() & 1) ? BOARD_SIZE - 1 : 0;
+        do
+        {
+            pos.candidate = {int(rng() % BOARD_SIZE), int(rng() % BOARD_SIZE), bool(rng() & 1), 0};
+        } while (!CanPlaceWall(pos.board, pos.candidate.x, pos.candidate.y, pos.candidate.horizontal));
+        pos.field = NewDistanceField(pos.board, pos.targetX);
+    }
+    return positions;
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 20000;
+    vector<Position> positions = MakePositions(count, 2025);
+
+    // 先确认两种实现结果一致
+    int blockedCount = 0;
+    for (const auto &pos : positions)
+    {
+        bool legacy = LegacyIsPathBlockedForPlayer(pos.px, pos.py, pos.targetX, pos.walls);
+        bool fast = !HasPathToGoal(pos.board, pos.px, pos.py, pos.targetX);
+        if (legacy != fast)
+        {
+            printf("Mismatch at (%d, %d) -> column %d with %zu walls\n", pos.px, pos.py, pos.targetX, pos.walls.size());
+            return 1;
+        }
+        blockedCount += fast;
+    }
+    printf("%d positions checked, %d blocked, results identical\n\n", count, blockedCount);
+
+    const int rounds = 50;
+    volatile int sink = 0;
+
+    allocationCount = 0;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (const auto &pos : positions)
+            sink += LegacyIsPathBlockedForPlayer(pos.px, pos.py, pos.targetX, pos.walls);
+    double legacySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long legacyAllocations = allocationCount;
+
+    allocationCount = 0;
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (const auto &pos : positions)
+            sink += !HasPathToGoal(pos.board, pos.px, pos.py, pos.targetX);
+    double fastSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long fastAllocations = allocationCount;
+
+    // 放墙检查：旧版 push_back + BFS + pop_back，对比距离场缓存
+    int touching = 0;
+    for (auto &pos : positions)
+    {
+        vector<Wall> withWall = pos.walls;
+        withWall.push_back(pos.candidate);
+        bool legacy = LegacyIsPathBlockedForPlayer(pos.px, pos.py, pos.targetX, withWall);
+        bool cached = !PathSurvivesWall(pos.board, pos.field, pos.px, pos.py, pos.candidate.x, pos.candidate.y, pos.candidate.horizontal);
+        if (legacy != cached)
+        {
+            printf("Wall check mismatch at (%d, %d)\n", pos.px, pos.py);
+            return 1;
+        }
+        BitBoard after = pos.board;
+        PlaceWall(after, pos.candidate.x, pos.candidate.y, pos.candidate.horizontal);
+        DistanceField updated = pos.field;
+        UpdateDistanceField(after, pos.candidate.x, pos.candidate.y, pos.candidate.horizontal, updated);
+        touching += updated.dist[CellIndex(pos.px, pos.py)] != pos.field.dist[CellIndex(pos.px, pos.py)];
+    }
+
+    allocationCount = 0;
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (auto &pos : positions)
+        {
+            pos.walls.push_back(pos.candidate);
+            sink += LegacyIsPathBlockedForPlayer(pos.px, pos.py, pos.targetX, pos.walls);
+            pos.walls.pop_back();
+        }
+    }
+    double legacyWallSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long legacyWallAllocations = allocationCount;
+
+    allocationCount = 0;
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (const auto &pos : positions)
+            sink += !PathSurvivesWall(pos.board, pos.field, pos.px, pos.py, pos.candidate.x, pos.candidate.y, pos.candidate.horizontal);
+    double cachedWallSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long cachedWallAllocations = allocationCount;
+
+    double calls = double(rounds) * count;
+    printf("%-28s %14s %16s\n", "", "calls/sec", "allocs/call");
+    printf("%-28s %14.0f %16.2f\n", "before (vector+queue+set)", calls / legacySeconds, legacyAllocations / calls);
+    printf("%-28s %14.0f %16.2f\n", "after  (bitboard+ring)", calls / fastSeconds, fastAllocations / calls);
+    printf("\nspeedup: %.1fx\n\n", legacySeconds / fastSeconds);
+
+    printf("wall check (%d of %d candidate walls lengthen the pawn's shortest path)\n", touching, count);
+    printf("%-28s %14s %16s\n", "", "calls/sec", "allocs/call");
+    printf("%-28s %14.0f %16.2f\n", "before (push + BFS + pop)", calls / legacyWallSeconds, legacyWallAllocations / calls);
+    printf("%-28s %14.0f %16.2f\n", "after  (distance cache)", calls / cachedWallSeconds, cachedWallAllocations / calls);
+    printf("\nspeedup: %.1fx\n", legacyWallSeconds / cachedWallSeconds);
+    return 0;
+}
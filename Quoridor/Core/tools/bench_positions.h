@@ -0,0 +1,48 @@
+#ifndef BENCH_POSITIONS_H
+#define BENCH_POSITIONS_H
+
+// 基准工具共用的几个固定局面（开局、早期放墙、中盘、赛跑）
+
+#include "game_state.h"
+#include <cstdio>
+
+struct BenchWall
+{
+    int x, y;
+    bool horizontal;
+};
+
+struct BenchPosition
+{
+    const char *name;
+    int x0, y0, x1, y1;
+    int wallsLeft0, wallsLeft1;
+    int turn;
+    int wallCount;
+    BenchWall walls[8];
+};
+
+static const BenchPosition positions[] = {
+    {"opening", 0, 4, 8, 4, 10, 10, 0, 0, {}},
+    {"early walls", 2, 4, 6, 4, 8, 8, 0, 4, {{6, 3, false}, {6, 5, false}, {2, 4, false}, {2, 2, false}}},
+    {"midgame", 4, 3, 5, 5, 6, 5, 1, 7, {{3, 3, true}, {5, 4, true}, {6, 2, false}, {3, 6, false}, {1, 5, true}, {7, 7, true}, {4, 1, false}}},
+    {"race", 6, 1, 2, 7, 2, 3, 0, 8, {{7, 1, false}, {7, 3, false}, {1, 6, false}, {1, 8, true}, {4, 5, true}, {5, 2, true}, {3, 4, false}, {6, 6, true}}},
+};
+
+// 把局面摆到 state 里，墙摆不下（表写错了）返回 false
+inline bool SetupBenchPosition(const BenchPosition &pos, GameState &state)
+{
+    BitBoard board = {};
+    for (int k = 0; k < pos.wallCount; k++)
+    {
+        if (!PlaceWall(board, pos.walls[k].x, pos.walls[k].y, pos.walls[k].horizontal))
+        {
+            printf("bad wall in position %s\n", pos.name);
+            return false;
+        }
+    }
+    SetupGame(state, board, pos.x0, pos.y0, pos.x1, pos.y1, pos.wallsLeft0, pos.wallsLeft1, pos.turn);
+    return true;
+}
+
+#endif
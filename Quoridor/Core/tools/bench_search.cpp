@@ -0,0 +1,59 @@
+// AI 搜索基准：固定几个局面跑迭代加深，输出每一层的节点数、累计用时和每秒节点数
+// 再用 1、2、4 ... 个线程（Lazy SMP）把每个局面搜到同一深度，对比到达该深度的用时和每秒节点数
+//
+// 编译（在 Quoridor/Core 目录下）：
+//   g++ -O2 -std=c++17 -pthread -Iinclude src/*.cpp tools/bench_search.cpp -o bench_search
+// 运行：
+//   ./bench_search [每个局面的时间预算 ms] [最大深度] [最多线程数]
+
+#include "bench_positions.h"
+#include "search.h"
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+int main(int argc, char **argv)
+{
+    int timeMs = argc > 1 ? atoi(argv[1]) : 2000;
+    int maxDepth = argc > 2 ? atoi(argv[2]) : MAX_SEARCH_DEPTH;
+    int maxThreads = argc > 3 ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    TranspositionTable tt;
+    InitTranspositionTable(tt, 64);
+
+    for (const auto &pos : positions)
+    {
+        GameState state;
+        if (!SetupBenchPosition(pos, state))
+            return 1;
+
+        ClearTranspositionTable(tt);
+        SearchLimits limits = {maxDepth, timeMs, 1};
+        SearchResult result = SearchBestMove(state, limits, tt);
+
+        printf("%s (%d ms budget)\n", pos.name, timeMs);
+        printf("  %5s %12s %10s %12s\n", "depth", "nodes", "ms", "nodes/sec");
+        for (int d = 1; d <= result.depth; d++)
+            printf("  %5d %12lld %10.1f %12.0f\n", d, result.depthNodes[d], result.depthSeconds[d] * 1000, result.depthNodes[d] / result.depthSeconds[d]);
+        printf("  best: %s (%d, %d)%s  score %d  depth %d  %.0f nodes/sec overall\n\n",
+               result.best.type == MOVE_PAWN ? "move" : "wall", result.best.x, result.best.y,
+               result.best.type == MOVE_WALL ? (result.best.horizontal ? " horizontal" : " vertical") : "",
+               result.score, result.depth, result.nodes / result.seconds);
+
+        // 线程扩展：不限时，搜到单线程达到的深度
+        printf("  %7s %14s %12s %10s\n", "threads", "time to depth", "nodes/sec", "speedup");
+        double baseSeconds = 0;
+        for (int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            ClearTranspositionTable(tt);
+            SearchResult scaled = SearchBestMove(state, {result.depth, 0, threads}, tt);
+            if (threads == 1)
+                baseSeconds = scaled.seconds;
+            printf("  %7d %11.1f ms %12.0f %9.2fx\n", threads, scaled.seconds * 1000, scaled.nodes / scaled.seconds, baseSeconds / scaled.seconds);
+        }
+        printf("\n");
+    }
+    return 0;
+}
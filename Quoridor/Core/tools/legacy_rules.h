@@ -0,0 +1,182 @@
+#ifndef LEGACY_RULES_H
+#define LEGACY_RULES_H
+
+// 基准工具共用的旧版规则实现（原 game.cpp 的写法），只用来对比速度和核对结果
+
+#include "board.h"
+#include <queue>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+struct Wall
+{
+    int x, y;
+    bool horizontal;
+    int playerid;
+};
+
+inline bool LegacyIsWallValid(const Wall &wall, const std::vector<Wall> &walls)
+{
+    if (wall.horizontal)
+    {
+        if (wall.x >= BOARD_SIZE - 1 || wall.y >= BOARD_SIZE)
+            return false;
+    }
+    else
+    {
+        if (wall.x >= BOARD_SIZE || wall.y >= BOARD_SIZE - 1)
+            return false;
+    }
+
+    // 同方向墙壁不能重叠，不同方向允许交叉
+    for (const auto &existingWall : walls)
+    {
+        if (existingWall.horizontal != wall.horizontal)
+            continue;
+        if (existingWall.horizontal)
+        {
+            if ((wall.x == existingWall.x || wall.x + 1 == existingWall.x || wall.x == existingWall.x + 1) && wall.y == existingWall.y)
+                return false;
+        }
+        else
+        {
+            if (wall.x == existingWall.x && (wall.y == existingWall.y || wall.y + 1 == existingWall.y || wall.y == existingWall.y + 1))
+                return false;
+        }
+    }
+    return true;
+}
+
+inline bool LegacyIsPathBlocked(int PlayerX, int PlayerY, int GoX, int GoY, const std::vector<Wall> &walls)
+{
+    if (PlayerY == GoY)
+    {
+        int minX = (PlayerX < GoX) ? PlayerX : GoX;
+        for (const auto &wall : walls)
+        {
+            if (!wall.horizontal && wall.x - 1 == minX && (wall.y == PlayerY || wall.y + 1 == PlayerY))
+                return true;
+        }
+    }
+    else if (PlayerX == GoX)
+    {
+        int minY = (PlayerY < GoY) ? PlayerY : GoY;
+        for (const auto &wall : walls)
+        {
+            if (wall.horizontal && (wall.x == PlayerX || wall.x + 1 == PlayerX) && wall.y == minY + 1)
+                return true;
+        }
+    }
+    return false;
+}
+
+inline bool LegacyIsPathBlockedForPlayer(int px, int py, int targetX, const std::vector<Wall> &walls)
+{
+    std::queue<std::pair<int, int>> q;
+    q.push({px, py});
+    std::unordered_set<int> visited;
+    visited.insert(px * BOARD_SIZE + py);
+
+    int dx[] = {0, 0, -1, 1};
+    int dy[] = {-1, 1, 0, 0};
+
+    while (!q.empty())
+    {
+        auto current = q.front();
+        q.pop();
+        int x = current.first;
+        int y = current.second;
+        if (x == targetX)
+            return false;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+            if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && !LegacyIsPathBlocked(x, y, nx, ny, walls))
+            {
+                int key = nx * BOARD_SIZE + ny;
+                if (visited.find(key) == visited.end())
+                {
+                    visited.insert(key);
+                    q.push({nx, ny});
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// 原 AnalyzeValidMoves 的走法规则（基本移动 + 跳跃 + 斜跳），按同样的顺序写进 movesX / movesY
+inline int LegacyPawnMoves(int px, int py, int ox, int oy, const std::vector<Wall> &walls, int movesX[6], int movesY[6])
+{
+    int count = 0;
+    auto add = [&](int x, int y)
+    {
+        movesX[count] = x;
+        movesY[count] = y;
+        count++;
+    };
+
+    if (px > 0 && !(px - 1 == ox && py == oy) && !LegacyIsPathBlocked(px, py, px - 1, py, walls))
+        add(px - 1, py);
+    if (px < BOARD_SIZE - 1 && !(px + 1 == ox && py == oy) && !LegacyIsPathBlocked(px, py, px + 1, py, walls))
+        add(px + 1, py);
+    if (py > 0 && !(px == ox && py - 1 == oy) && !LegacyIsPathBlocked(px, py, px, py - 1, walls))
+        add(px, py - 1);
+    if (py < BOARD_SIZE - 1 && !(px == ox && py + 1 == oy) && !LegacyIsPathBlocked(px, py, px, py + 1, walls))
+        add(px, py + 1);
+
+    if (px > 1 && (px - 1 == ox && py == oy) && !LegacyIsPathBlocked(px, py, px - 1, py, walls))
+    {
+        if (!LegacyIsPathBlocked(px - 1, py, px - 2, py, walls))
+            add(px - 2, py);
+        else
+        {
+            if (py > 0 && !LegacyIsPathBlocked(px - 1, py, px - 1, py - 1, walls))
+                add(px - 1, py - 1);
+            if (py < BOARD_SIZE - 1 && !LegacyIsPathBlocked(px - 1, py, px - 1, py + 1, walls))
+                add(px - 1, py + 1);
+        }
+    }
+    if (px < BOARD_SIZE - 2 && (px + 1 == ox && py == oy) && !LegacyIsPathBlocked(px, py, px + 1, py, walls))
+    {
+        if (!LegacyIsPathBlocked(px + 1, py, px + 2, py, walls))
+            add(px + 2, py);
+        else
+        {
+            if (py > 0 && !LegacyIsPathBlocked(px + 1, py, px + 1, py - 1, walls))
+                add(px + 1, py - 1);
+            if (py < BOARD_SIZE - 1 && !LegacyIsPathBlocked(px + 1, py, px + 1, py + 1, walls))
+                add(px + 1, py + 1);
+        }
+    }
+    if (py > 1 && (px == ox && py - 1 == oy) && !LegacyIsPathBlocked(px, py, px, py - 1, walls))
+    {
+        if (!LegacyIsPathBlocked(px, py - 1, px, py - 2, walls))
+            add(px, py - 2);
+        else
+        {
+            if (px > 0 && !LegacyIsPathBlocked(px, py - 1, px - 1, py - 1, walls))
+                add(px - 1, py - 1);
+            if (px < BOARD_SIZE - 1 && !LegacyIsPathBlocked(px, py - 1, px + 1, py - 1, walls))
+                add(px + 1, py - 1);
+        }
+    }
+    if (py < BOARD_SIZE - 2 && (px == ox && py + 1 == oy) && !LegacyIsPathBlocked(px, py, px, py + 1, walls))
+    {
+        if (!LegacyIsPathBlocked(px, py + 1, px, py + 2, walls))
+            add(px, py + 2);
+        else
+        {
+            if (px > 0 && !LegacyIsPathBlocked(px, py + 1, px - 1, py + 1, walls))
+                add(px - 1, py + 1);
+            if (px < BOARD_SIZE - 1 && !LegacyIsPathBlocked(px, py + 1, px + 1, py + 1, walls))
+                add(px + 1, py + 1);
+        }
+    }
+    return count;
+}
+
+#endif
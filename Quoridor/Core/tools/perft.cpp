@@ -0,0 +1,216 @@
+// Perft：从固定局面出发，把所有合法着法（走一步、跳跃、斜跳、放墙）展开到第 N 层，数叶子节点
+// 每一层输出节点数、最后一层着法的分类、用时和每秒节点数，并和表里记下的参考值比对
+// 以后改规则代码（走法、墙壁合法性、距离场）时，先跑一遍确认数字没变，再看速度
+//
+// 编译（在 Quoridor/Core 目录下）：
+//   g++ -O2 -std=c++17 -Iinclude src/*.cpp tools/perft.cpp -o perft
+// 运行：
+//   ./perft [最大深度]            用 GameState（GenerateMoves / ApplyMove）展开
+//   ./perft [最大深度] legacy     用原 game.cpp 的 std::vector<Wall> 写法再数一遍（很慢，深度 2 就够核对）
+//
+// 已经分出胜负的局面不再展开（贡献 0 个叶子）；参考值为 0 表示还没记录
+// 最后一层只数不走（不调用 ApplyMove），每秒节点数主要反映着法生成和墙壁合法性的速度
+
+#include "bench_positions.h"
+#include "legacy_rules.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+const int PERFT_REFERENCE_DEPTH = 3; // 表里记到第几层
+
+struct PerftPosition
+{
+    BenchPosition position;
+    long long expected[PERFT_REFERENCE_DEPTH + 1]; // expected[d] = 第 d 层的叶子数
+};
+
+// 基准局面 + 专门测跳跃的局面；参考值用 GameState 和旧写法各数了一遍，到第 3 层完全一致
+static const PerftPosition perftPositions[] = {
+    {positions[0], {1, 131, 16805, 2110420}},
+    {positions[1], {1, 121, 14317, 1655810}},
+    {positions[2], {1, 112, 12142, 1295893}},
+    {positions[3], {1, 107, 11255, 1142154}},
+    // 面对面：直接跳过对手
+    {{"face to face", 4, 4, 5, 4, 10, 10, 0, 0, {}}, {1, 132, 17066, 2160396}},
+    // 对手身后有墙：只能斜跳
+    {{"diagonal jump", 4, 4, 5, 4, 5, 5, 0, 2, {{6, 4, false}, {3, 2, true}}}, {1, 127, 15541, 1887993}},
+    // 对手贴着边框：跳不过去，也不能斜跳
+    {{"edge jump", 4, 1, 4, 0, 3, 3, 0, 1, {{7, 7, true}}}, {1, 129, 16293, 2013858}},
+    // 双方都没有墙了：只剩走棋
+    {{"no walls left", 3, 2, 5, 6, 0, 0, 0, 6, {{4, 3, true}, {6, 3, true}, {2, 5, false}, {5, 0, false}, {7, 6, true}, {4, 7, false}}}, {1, 4, 16, 60}},
+};
+
+// 最后一层着法的分类
+struct PerftCounts
+{
+    long long nodes;
+    long long steps;     // 走一格
+    long long jumps;     // 直线跳过对手
+    long long diagonals; // 斜跳
+    long long walls;     // 放墙
+};
+
+static void CountMove(PerftCounts &counts, int fromX, int fromY, int toX, int toY, bool wall)
+{
+    counts.nodes++;
+    if (wall)
+        counts.walls++;
+    else if (abs(toX - fromX) + abs(toY - fromY) == 1)
+        counts.steps++;
+    else if (toX == fromX || toY == fromY)
+        counts.jumps++;
+    else
+        counts.diagonals++;
+}
+
+// ------------------------------GameState------------------------------
+
+static void Perft(GameState &state, int depth, PerftCounts &counts)
+{
+    if (Winner(state) >= 0)
+        return;
+
+    Move moves[MAX_MOVES];
+    int count = GenerateMoves(state, moves);
+    int me = state.turn;
+    for (int k = 0; k < count; k++)
+    {
+        if (depth == 1)
+        {
+            CountMove(counts, state.x[me], state.y[me], moves[k].x, moves[k].y, moves[k].type == MOVE_WALL);
+            continue;
+        }
+        GameState child = state;
+        ApplyMove(child, moves[k]);
+        Perft(child, depth - 1, counts);
+    }
+}
+
+// ------------------------------旧写法------------------------------
+
+struct LegacyPosition
+{
+    int x[2], y[2];
+    int wallsLeft[2];
+    int turn;
+    std::vector<Wall> walls;
+};
+
+static bool LegacyWallLegal(LegacyPosition &pos, const Wall &wall)
+{
+    if (!LegacyIsWallValid(wall, pos.walls))
+        return false;
+    pos.walls.push_back(wall);
+    bool blocked = LegacyIsPathBlockedForPlayer(pos.x[0], pos.y[0], BOARD_SIZE - 1, pos.walls) ||
+                   LegacyIsPathBlockedForPlayer(pos.x[1], pos.y[1], 0, pos.walls);
+    pos.walls.pop_back();
+    return !blocked;
+}
+
+static void LegacyPerft(LegacyPosition &pos, int depth, PerftCounts &counts)
+{
+    if (pos.x[0] == BOARD_SIZE - 1 || pos.x[1] == 0)
+        return;
+
+    int me = pos.turn;
+    int movesX[6], movesY[6];
+    int count = LegacyPawnMoves(pos.x[me], pos.y[me], pos.x[1 - me], pos.y[1 - me], pos.walls, movesX, movesY);
+    for (int k = 0; k < count; k++)
+    {
+        if (depth == 1)
+        {
+            CountMove(counts, pos.x[me], pos.y[me], movesX[k], movesY[k], false);
+            continue;
+        }
+        int oldX = pos.x[me], oldY = pos.y[me];
+        pos.x[me] = movesX[k];
+        pos.y[me] = movesY[k];
+        pos.turn = 1 - me;
+        LegacyPerft(pos, depth - 1, counts);
+        pos.x[me] = oldX;
+        pos.y[me] = oldY;
+        pos.turn = me;
+    }
+
+    if (pos.wallsLeft[me] == 0)
+        return;
+    // 边框上的墙不算（x = 0 的垂直墙、y = 0 的水平墙），和 WallToSlot 一致
+    for (int o = 0; o < 2; o++)
+    {
+        bool horizontal = o == 0;
+        for (int x = horizontal ? 0 : 1; x < (horizontal ? BOARD_SIZE - 1 : BOARD_SIZE); x++)
+        {
+            for (int y = horizontal ? 1 : 0; y < (horizontal ? BOARD_SIZE : BOARD_SIZE - 1); y++)
+            {
+                Wall wall = {x, y, horizontal, me};
+                if (!LegacyWallLegal(pos, wall))
+                    continue;
+                if (depth == 1)
+                {
+                    CountMove(counts, 0, 0, 0, 0, true);
+                    continue;
+                }
+                pos.walls.push_back(wall);
+                pos.wallsLeft[me]--;
+                pos.turn = 1 - me;
+                LegacyPerft(pos, depth - 1, counts);
+                pos.walls.pop_back();
+                pos.wallsLeft[me]++;
+                pos.turn = me;
+            }
+        }
+    }
+}
+
+// ------------------------------主程序------------------------------
+
+int main(int argc, char **argv)
+{
+    int maxDepth = argc > 1 ? atoi(argv[1]) : PERFT_REFERENCE_DEPTH;
+    bool legacy = argc > 2 && strcmp(argv[2], "legacy") == 0;
+    int mismatches = 0;
+
+    for (const auto &perftPos : perftPositions)
+    {
+        const BenchPosition &pos = perftPos.position;
+        GameState state;
+        if (!SetupBenchPosition(pos, state))
+            return 1;
+        LegacyPosition legacyPos = {{pos.x0, pos.x1}, {pos.y0, pos.y1}, {pos.wallsLeft0, pos.wallsLeft1}, pos.turn, {}};
+        for (int k = 0; k < pos.wallCount; k++)
+            legacyPos.walls.push_back({pos.walls[k].x, pos.walls[k].y, pos.walls[k].horizontal, 0});
+
+        printf("%s%s\n", pos.name, legacy ? " (legacy rules)" : "");
+        printf("  %5s %12s %10s %10s %10s %12s %10s %12s  %s\n", "depth", "nodes", "steps", "jumps", "diagonal", "walls", "ms", "nodes/sec", "reference");
+        for (int depth = 1; depth <= maxDepth; depth++)
+        {
+            PerftCounts counts = {};
+            auto start = std::chrono::steady_clock::now();
+            if (legacy)
+                LegacyPerft(legacyPos, depth, counts);
+            else
+                Perft(state, depth, counts);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const char *verdict = "-";
+            if (depth <= PERFT_REFERENCE_DEPTH && perftPos.expected[depth] != 0)
+            {
+                verdict = counts.nodes == perftPos.expected[depth] ? "ok" : "MISMATCH";
+                if (counts.nodes != perftPos.expected[depth])
+                    mismatches++;
+            }
+            printf("  %5d %12lld %10lld %10lld %10lld %12lld %10.1f %12.0f  %s\n", depth, counts.nodes, counts.steps, counts.jumps, counts.diagonals, counts.walls,
+                   seconds * 1000, seconds > 0 ? counts.nodes / seconds : 0.0, verdict);
+        }
+        printf("\n");
+    }
+
+    if (mismatches > 0)
+    {
+        printf("%d mismatches against the reference counts\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
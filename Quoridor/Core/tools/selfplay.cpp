@@ -0,0 +1,135 @@
+// 无界面自对弈：不需要 raylib，多个线程同时下 N 局，把每局的结果和着法写到文件里
+// 输出每秒对局数、每秒步数和双方胜率
+//
+// 编译（在 Quoridor/Core 目录下）：
+//   g++ -O2 -std=c++17 -pthread -Iinclude src/*.cpp tools/selfplay.cpp -o selfplay
+// 运行：
+//   ./selfplay [对局数] [白方策略] [黑方策略] [线程数] [输出文件]
+//   策略：random、greedy、search[:深度]、mcts[:模拟次数]，例如 ./selfplay 1000 greedy search:2 4 games.txt
+//
+// 输出文件每局一行：局号 胜者(0 白 / 1 黑 / -1 和) 步数 着法...（着法写法见 FormatMove）
+// 按局号顺序边下边写：前面的局都下完了就马上写出去，中途停下已经写的也还在
+// 领到的局号最多比还没写出去的最早一局超前 线程数 × PENDING_PER_THREAD 局，碰上一局特别长的也只攒这么多，内存不随对局数增长
+
+#include "policy.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const int PENDING_PER_THREAD = 4; // 下完等着写的局最多 线程数 × 这么多；太小了碰上长局其他线程要停下来等
+
+struct SelfplayShared
+{
+    PolicyConfig players[2];
+    int games;
+    std::atomic<int> next; // 下一局的局号
+
+    int window;            // 领到的局号最多比 written 超前这么多（线程数 × PENDING_PER_THREAD）
+
+    std::mutex outputMutex;               // 保护下面这些
+    std::condition_variable advanced;     // written 增加了（等着开新局的线程可以继续）
+    FILE *file;
+    std::map<int, GameRecord> pending;    // 下完了、但前面还有局没下完的（少于 window 局）
+    std::atomic<int> written{0};          // 已经写出去的局数（= 下一局要写的局号 - 1）；只在锁里改，领新局时先不加锁看一眼
+    long long moves = 0;
+    int wins[3] = {};                     // 白胜、黑胜、和棋
+};
+
+static void WriteRecord(SelfplayShared *shared, int game, const GameRecord &record) // 调用方持有 outputMutex
+{
+    fprintf(shared->file, "%d %d %d", game + 1, record.winner, record.plies);
+    for (int k = 0; k < record.plies; k++)
+    {
+        char text[4];
+        FormatMove(record.moves[k], text);
+        fprintf(shared->file, " %s", text);
+    }
+    fprintf(shared->file, "\n");
+    shared->moves += record.plies;
+    shared->wins[record.winner >= 0 ? record.winner : 2]++;
+}
+
+static void SelfplayWorker(SelfplayShared *shared)
+{
+    PolicyWorker worker;
+    InitPolicyWorker(worker, 0);
+    GameRecord record;
+    for (int game = shared->next.fetch_add(1); game < shared->games; game = shared->next.fetch_add(1))
+    {
+        if (game - shared->written.load() >= shared->window)
+        {
+            // 最早没写出去的那局一直没下完（它的局号在窗口里，所以有线程在下它）：先等它，不然 pending 会越攒越多
+            std::unique_lock<std::mutex> lock(shared->outputMutex);
+            shared->advanced.wait(lock, [&]
+                                  { return game - shared->written < shared->window; });
+        }
+        PlayGame(shared->players, worker, game + 1, record); // 局号当种子，单独重放某一局也是同样的结果
+
+        std::lock_guard<std::mutex> lock(shared->outputMutex);
+        if (game != shared->written)
+        {
+            shared->pending[game] = record; // 前面还有局没下完，先放着
+            continue;
+        }
+        WriteRecord(shared, game, record);
+        shared->written++;
+        for (auto found = shared->pending.find(shared->written); found != shared->pending.end(); found = shared->pending.find(shared->written))
+        {
+            WriteRecord(shared, found->first, found->second);
+            shared->pending.erase(found);
+            shared->written++;
+        }
+        fflush(shared->file);
+        shared->advanced.notify_all();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int games = argc > 1 ? atoi(argv[1]) : 1000;
+    const char *whiteName = argc > 2 ? argv[2] : "greedy";
+    const char *blackName = argc > 3 ? argv[3] : "random";
+    int threads = argc > 4 ? atoi(argv[4]) : (int)std::thread::hardware_concurrency();
+    const char *outputPath = argc > 5 ? argv[5] : "selfplay.txt";
+    if (threads < 1)
+        threads = 1;
+
+    SelfplayShared shared;
+    if (!ParsePolicy(whiteName, shared.players[0]) || !ParsePolicy(blackName, shared.players[1]))
+    {
+        printf("unknown policy (use random, greedy, search[:depth], mcts[:playouts])\n");
+        return 1;
+    }
+    shared.file = fopen(outputPath, "w");
+    if (!shared.file)
+    {
+        printf("cannot open %s\n", outputPath);
+        return 1;
+    }
+    shared.games = games;
+    shared.next.store(0);
+    shared.window = threads * PENDING_PER_THREAD;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int k = 0; k < threads; k++)
+        workers.emplace_back(SelfplayWorker, &shared);
+    for (auto &worker : workers)
+        worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fclose(shared.file);
+    long long moves = shared.moves;
+    const int *wins = shared.wins;
+
+    printf("%s (white) vs %s (black), %d games, %d threads\n", whiteName, blackName, games, threads);
+    printf("  white %d  black %d  draw %d\n", wins[0], wins[1], wins[2]);
+    printf("  %.2f s  %.1f games/sec  %.0f moves/sec  %.1f moves/game\n", seconds, games / seconds, moves / seconds, games > 0 ? (double)moves / games : 0.0);
+    printf("  games written to %s\n", outputPath);
+    return 0;
+}
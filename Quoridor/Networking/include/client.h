@@ -1,24 +1,28 @@
-#ifndef CLIENT_H
-#define CLIENT_H
-
-#include <string>
-
-extern char clientName[256];
-extern int actionType  ;
-extern int x , y ;
-extern bool isHorizontal ;
-extern int currentTurn ;
-
-const char *getClientName(); // 获取clientName函数（ room.cpp to client.cpp)
-
-extern std::string GameMessage ;
-
-
-
-// **启动客户端线程（非阻塞）**
-void startClientThread();
-
-std::string getClientID();
-std::string getOpponentName();
-
-#endif  
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include <string>
+
+struct MoveQueue; // move_queue.h
+
+extern char clientName[256];
+extern int currentTurn ; // 只由渲染线程读写：对手的着法从 incomingMoves 取出来时才换手
+
+const char *getClientName(); // 获取clientName函数（ room.cpp to client.cpp)
+
+extern MoveQueue outgoingMoves; // Game() 走完一步放进来，网络线程马上发给服务器
+extern MoveQueue incomingMoves; // 网络线程收到对手的着法放进来，Game() 每帧取
+
+void SubmitUsername(const char *name); // 名字确认后调用，唤醒等名字的网络线程
+
+void setServerAddress(const char *address); // "主机:端口"，在 startClientThread 之前调用；空指针或空字符串不改
+std::string getNetworkStats();              // 请求数、每秒请求数、每个接口的往返时间中位数（多行文本）
+
+
+// **启动客户端线程（非阻塞）**
+void startClientThread();
+
+std::string getClientID();
+std::string getOpponentName();
+
+#endif  
@@ -0,0 +1,79 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <cstdint>
+#include <string>
+
+// TCP 长连接的帧格式（服务器的第二个端口，默认 HTTP 端口 + 1；客户端先连它，连不上再用 HTTP 轮询）
+// 一帧 = 2 字节长度（小端，类型 + 内容的字节数）+ 1 字节类型 + 内容
+//
+// 客户端 -> 服务器
+//   FRAME_JOIN    名字                         配对，和 /login 一样，回 FRAME_SEAT
+//   FRAME_WATCH   房间号 4 字节                观战，回 FRAME_SEAT（座位 0），房间不存在回 FRAME_REJECT
+//   FRAME_MOVE    着法包 MOVE_PACKET_BYTES 字节 走一步，和 /message 的 body 一样，没走成回 FRAME_REJECT
+// 服务器 -> 客户端（有变化就推，客户端不用问）
+//   FRAME_SEAT    房间号 4 字节 + 座位 1 字节
+//   FRAME_START   座位 1 的名字 + '\n' + 座位 2 的名字（双方到齐）
+//   FRAME_MOVE    着法包 + 走完以后轮到的座位 1 字节；推给双方和观战的人，走棋的一方收到就是确认
+//   FRAME_END     胜方座位 1 字节（和棋 0）
+//   FRAME_REJECT  原因 1 字节（服务器的 MoveResult）+ 说明文字
+// 订阅（JOIN / WATCH）以后服务器先补发到齐、已经走过的着法和结束，之后每一步都推
+
+const uint8_t FRAME_JOIN = 1;
+const uint8_t FRAME_WATCH = 2;
+const uint8_t FRAME_MOVE = 3;
+const uint8_t FRAME_SEAT = 4;
+const uint8_t FRAME_START = 5;
+const uint8_t FRAME_END = 6;
+const uint8_t FRAME_REJECT = 7;
+
+const size_t FRAME_HEADER_BYTES = 3;
+const size_t MAX_FRAME_BYTES = 1024; // 类型 + 内容最多这么长，超过就断开连接
+
+// 追加一帧到 out
+inline void AppendFrame(std::string &out, uint8_t type, const std::string &payload)
+{
+    size_t length = payload.size() + 1;
+    out += (char)(length & 0xFF);
+    out += (char)(length >> 8);
+    out += (char)type;
+    out += payload;
+}
+
+// 从 buffer 的 offset 处取一帧，取到就把 offset 挪到下一帧；不完整返回 false，长度不对时 bad = true
+inline bool NextFrame(const std::string &buffer, size_t &offset, uint8_t &type, std::string &payload, bool &bad)
+{
+    bad = false;
+    if (buffer.size() - offset < FRAME_HEADER_BYTES)
+        return false;
+    size_t length = (uint8_t)buffer[offset] | (size_t)(uint8_t)buffer[offset + 1] << 8;
+    if (length == 0 || length > MAX_FRAME_BYTES)
+    {
+        bad = true;
+        return false;
+    }
+    if (buffer.size() - offset < 2 + length)
+        return false;
+    type = (uint8_t)buffer[offset + 2];
+    payload.assign(buffer, offset + FRAME_HEADER_BYTES, length - 1);
+    offset += 2 + length;
+    return true;
+}
+
+inline std::string PackRoom(uint32_t roomId) // 房间号 4 字节，小端
+{
+    std::string bytes(4, '\0');
+    for (int k = 0; k < 4; k++)
+        bytes[k] = (char)(roomId >> (8 * k));
+    return bytes;
+}
+
+inline uint32_t UnpackRoom(const std::string &bytes)
+{
+    uint32_t roomId = 0;
+    for (int k = 0; k < 4 && k < (int)bytes.size(); k++)
+        roomId |= (uint32_t)(uint8_t)bytes[k] << (8 * k);
+    return roomId;
+}
+
+#endif
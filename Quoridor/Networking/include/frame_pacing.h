@@ -0,0 +1,16 @@
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+#include <string>
+
+// 自适应帧率：有东西在变（输入、收到对手着法、动画还没播完）时按全速画，安静下来以后降到低帧率
+// 等对手想几分钟的时候不用一直每秒画 60 帧
+// raylib 的 EnableEventWaiting 只会被输入事件叫醒，网络线程收到着法叫不醒它，所以空闲时降帧率而不是阻塞
+
+extern bool adaptivePacing; // F5 切换：关掉就是原来的固定 60 FPS（对比用）
+
+void MarkFrameDirty();        // 渲染线程里有东西变了：接下来保持全速
+void PaceFrames();            // EndDrawing 之后调用：看这一帧有没有输入或被标脏，决定下一帧的目标帧率
+std::string GetPacingStats(); // 实际帧率和目标帧率（叠加层用）
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <string>
+
+// 调试叠加层（F3）的每帧统计：发了多少个绘制调用、画一帧花了多少 CPU 时间
+// 绘制调用由各个 Draw 函数自己加到 drawCalls 上（raylib 不提供这个数）
+
+extern int drawCalls;           // 这一帧到现在为止的绘制调用数
+extern bool cacheStaticLayers;  // F4 切换：不变的部分（棋盘、菜单和胜利界面的装饰）画进纹理缓存 / 每帧重画（对比用）
+
+void BeginFrameStats();      // BeginDrawing 之后调用：清零，开始计时
+void EndFrameStats();        // 画完、EndDrawing 之前调用：把批量绘制提交掉，记下这一帧的时间
+std::string GetFrameStats(); // 最近 FRAME_STATS_WINDOW 帧的平均和最慢一帧的毫秒数、平均绘制调用数
+
+#endif
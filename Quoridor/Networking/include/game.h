@@ -1,14 +1,15 @@
-#ifndef GAME_H
-#define GAME_H
-
-#include "raylib.h"
-#include <vector>
-
-extern int winner ;
-
-int  Game();
-void DrawGame();
-void DrawVictory(int winner);
-void ResetGame();
-
-#endif 
+#ifndef GAME_H
+#define GAME_H
+
+#include "raylib.h"
+#include <vector>
+
+extern int winner ;
+
+int  Game();
+void DrawGame();
+void DrawVictory(int winner);
+void ResetGame();
+void UnloadGame(); // 释放棋盘纹理
+
+#endif 
@@ -0,0 +1,36 @@
+#ifndef MOVE_QUEUE_H
+#define MOVE_QUEUE_H
+
+#include "game_state.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// 渲染线程和网络线程之间传着法的队列（互斥锁 + 条件变量）
+// 发出去：Game() 走完一步放进去，网络线程在 WaitMove 里被唤醒，马上发 /message
+// 收进来：网络线程把 /wait 收到的对手着法放进去，Game() 每帧用 PollMove 取，不会卡住画面
+// 原来两边直接读写 actionType / x / y / GameMessage，没有加锁，网络线程还每秒才看一次
+
+struct QueuedMove
+{
+    Move move;
+    int seat;                                        // 走这一步的座位 1 / 2
+    std::chrono::steady_clock::time_point committed; // 放进队列的时间，用来算从点击到发出的延迟
+};
+
+struct MoveQueue
+{
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<QueuedMove> moves;
+    bool closed = false; // 关掉以后 WaitMove 不再等
+};
+
+void PushMove(MoveQueue &queue, const Move &move, int seat);     // 放进一步，唤醒等着的线程
+bool PollMove(MoveQueue &queue, QueuedMove &out);                // 不等：有就取出来返回 true
+bool WaitMove(MoveQueue &queue, QueuedMove &out, int timeoutMs); // 等到有一步（或者超时、队列关掉）；timeoutMs < 0 一直等
+void CloseMoveQueue(MoveQueue &queue);                           // 唤醒所有等着的线程，之后 WaitMove 马上返回
+void ClearMoveQueue(MoveQueue &queue);                           // 清空并重新打开（新的一局）
+
+#endif
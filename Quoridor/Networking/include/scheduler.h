@@ -0,0 +1,13 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <functional>
+
+// 渲染线程的延时任务：要"过一会儿再做"的事放进来，每帧开头把到时间的执行掉
+// 代替在渲染线程里 sleep（sleep 的时候整个窗口都不出帧）
+
+void ScheduleTask(double delaySeconds, std::function<void()> task); // delaySeconds 秒以后在渲染线程里执行 task
+void RunScheduledTasks();                                           // 每帧开头调用：按到期先后执行已经到时间的任务
+bool HasScheduledTasks();                                           // 还有任务在等（自适应帧率据此保持全速，任务不会晚一个空闲帧）
+
+#endif
@@ -1,142 +1,442 @@
-#include "thirdparty/httplib.h"
-#include "unordered_map"
-
-#include <mutex>
-using namespace std;
-
-unordered_map<string, int> userbook;
-
-std::vector<std::string> message_history;
-mutex message_mutex;
-
-int client_id;
-int current_client_id = 1;
-int connected_clients = 0;
-
-void login(const httplib::Request &req, httplib::Response &res);
-
-void message(const httplib::Request &req, httplib::Response &res);
-
-void get_turn(const httplib::Request &req, httplib::Response &res);
-
-void ready(const httplib::Request &req, httplib::Response &res);
-
-void get_messages(const httplib::Request &req, httplib::Response &res);
-
-int main()
-{
-    httplib::Server server;
-    cout << "Server listening the port 25565..." << endl
-         << endl;
-
-    server.Post("/login", login);
-    server.Get("/ready", ready);
-    server.Post("/message", message);
-    server.Get("/turn", get_turn);
-    server.Get("/messages",get_messages);
-
-    server.listen("0.0.0.0", 25565); // 所有设备都可以连接此电脑
-    return 0;
-}
-
-
-
-//--------------------------------函数体---------------------------------------------------------------------
-
-//--------------------------------函数体---------------------------------------------------------------------
-
-void login(const httplib::Request &req, httplib::Response &res)
-{
-    string username = req.body; // 1.从client获取名字
-
-    if (userbook.size() >= 2) // 判断多少个用户
-    {
-        res.set_content("Server is full.Please try again later", "text/plain");
-        return;
-    }
-    else
-    {
-        if (userbook.find(username) == userbook.end()) // 如果用户名不存在
-        {
-            client_id = userbook.size() + 1; // 新的ID
-            connected_clients += 1;
-            userbook[username] = client_id; // 绑定用户名和 ID
-        }
-        else
-        {
-            client_id = userbook[username]; // 获取已存在的 ID
-        }
-
-        res.set_content(to_string(client_id), "text/plain"); // 返回ID
-
-        cout << "Client " << client_id << " [" << username << "] connected from " << req.remote_addr << endl;
-    }
-}
-
-void ready(const httplib::Request &req, httplib::Response &res) // 向用户输出需要等待还是开始
-{
-    if (connected_clients < 2)
-    {
-        res.set_content("Waiting", "text/plain"); // client基于waiting这个字来等待opponent名字准没准备好
-    }
-    else
-    {
-        string opponentName;
-        for (const auto &pair : userbook)
-        {
-            if (pair.second != stoi(req.get_header_value("Client-ID")))
-            {
-                opponentName = pair.first;
-                break;
-            }
-        }
-        res.set_content(opponentName, "text/plain");
-    }
-}
-
-void message(const httplib::Request &req, httplib::Response &res)
-{
-    int client_id = stoi(req.get_header_value("Client-ID")); // 根据client发来的ID知道是哪个client
-
-    if (client_id != current_client_id ) // 检查是否是当前回合的客户端
-    {
-        res.set_content("Not your turn to send message.", "text/plain");
-        return;
-    }
-
-    int actionType = stoi(req.get_header_value("Action-Type"));
-    int x = stoi(req.get_header_value("X"));
-    int y = stoi(req.get_header_value("Y"));
-    bool isHorizontal = stoi(req.get_header_value("Is-Horizontal"));
-
-    string message = "Client " + to_string(client_id) + " sent message: " + req.body;
-    {
-        lock_guard<mutex> lock(message_mutex); // 加锁保护消息历史记录
-        message_history.push_back(message);    // 将消息添加到历史记录中
-    }
-
-    cout << "Client " << to_string(client_id) << " sent message: " << req.body << endl;
-
-    current_client_id = (current_client_id == 1) ? 2 : 1;
-    res.set_content(to_string(current_client_id), "text/plain"); // 返回更新后的回合
-}
-
-void get_turn(const httplib::Request &req, httplib::Response &res) // 发送当前回合
-{
-    res.set_content(to_string(current_client_id), "text/plain");
-}
-
-void get_messages(const httplib::Request &req, httplib::Response &res)
-{
-    lock_guard<mutex> lock(message_mutex); // 加锁保护消息历史记录
-
-    if (!message_history.empty())
-    {
-        // 只返回最新的消息
-        res.set_content(message_history.back(), "text/plain");
-    }
-    else
-    {
-        res.set_content("No messages yet.", "text/plain"); // 处理空消息历史记录
-    }
-}
+#include "thirdparty/httplib.h"
+#include "server/match.h"
+#include "server/archive.h"
+#include "server/stream.h"
+#include "server/epoll_server.h"
+#include "game_state.h"
+
+#include <atomic>
+#include <climits>
+#include <ctime>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+using namespace std;
+
+const int LONG_POLL_SECONDS = 25; // /wait 最多挂起这么久，没有新消息就原样返回，客户端再发一次
+const int DEFAULT_PORT = 25565;
+const int DEFAULT_THREADS = 64;   // 处理请求的线程数（长轮询会占住线程，要比同时在线的人数多）
+const int DEFAULT_EPOLL_WORKERS = 4; // --epoll 时的工作线程数（挂起的 /wait 不占线程，几个就够）
+const int SWEEP_SECONDS = 10;     // 每隔多久清一次下完的房间
+const int ARCHIVE_LIMIT = 50;     // /archive 默认最多返回几局
+
+void login(const httplib::Request &req, httplib::Response &res);
+
+void message(const httplib::Request &req, httplib::Response &res);
+
+void get_turn(const httplib::Request &req, httplib::Response &res);
+
+void ready(const httplib::Request &req, httplib::Response &res);
+
+void get_messages(const httplib::Request &req, httplib::Response &res);
+
+void wait_message(const httplib::Request &req, httplib::Response &res);
+
+bool poll_wait_message(const httplib::Request &req, httplib::Response &res, bool timed_out);
+
+void get_moves(const httplib::Request &req, httplib::Response &res);
+
+void get_archive(const httplib::Request &req, httplib::Response &res);
+
+void get_stats(const httplib::Request &req, httplib::Response &res);
+
+int main(int argc, char **argv)
+{
+    bool use_epoll = false; // --epoll：用 epoll 后端（只有 Linux），可以放在任何位置
+    vector<char *> args;
+    for (int i = 0; i < argc; i++)
+    {
+        if (string(argv[i]) == "--epoll")
+            use_epoll = true;
+        else
+            args.push_back(argv[i]);
+    }
+    argc = (int)args.size();
+    argv = args.data();
+
+    int port = argc > 1 ? atoi(argv[1]) : DEFAULT_PORT;          // ./server [--epoll] [端口] [线程数] [存档文件] [长连接端口]
+    int threads = argc > 2 ? atoi(argv[2]) : (use_epoll ? DEFAULT_EPOLL_WORKERS : DEFAULT_THREADS);
+    string archive_path = argc > 3 ? argv[3] : "matches.archive";
+    int stream_port = argc > 4 ? atoi(argv[4]) : port + 1;      // 0 = 不开 TCP 长连接，只用 HTTP
+
+    if (OpenArchive(archive_path))
+    {
+        cout << "Archive " << archive_path << ": " << ArchivedGames() << " games" << endl;
+    }
+    else
+    {
+        cout << "Cannot open archive " << archive_path << ", finished games will not be saved" << endl;
+    }
+
+    if (stream_port > 0)
+    {
+        if (StartStreamServer(stream_port))
+        {
+            cout << "Stream (TCP) listening the port " << stream_port << "..." << endl;
+        }
+        else
+        {
+            cout << "Cannot listen the stream port " << stream_port << ", HTTP only" << endl;
+        }
+    }
+
+    thread([]
+           {
+               while (true)
+               {
+                   this_thread::sleep_for(chrono::seconds(SWEEP_SECONDS));
+                   SweepMatches(); // 下完的和没人管的房间连同着法日志一起释放，内存不会一直涨
+               } })
+        .detach();
+
+    if (use_epoll) // 同样的接口和处理函数，只是连接由几个 epoll 线程处理，/wait 挂起时不占线程
+    {
+        vector<EpollRoute> routes = {
+            {"POST", "/login", login, nullptr},
+            {"POST", "/match", login, nullptr},
+            {"GET", "/ready", ready, nullptr},
+            {"POST", "/message", message, nullptr},
+            {"GET", "/turn", get_turn, nullptr},
+            {"GET", "/messages", get_messages, nullptr},
+            {"GET", "/wait", nullptr, poll_wait_message},
+            {"GET", "/moves", get_moves, nullptr},
+            {"GET", "/archive", get_archive, nullptr},
+            {"GET", "/stats", get_stats, nullptr},
+        };
+        cout << "Server (epoll, " << threads << " workers) listening the port " << port << "..." << endl
+             << endl;
+        if (!RunEpollServer(port, threads, routes, LONG_POLL_SECONDS))
+        {
+            cout << "Cannot listen the port " << port << endl;
+        }
+        return 0;
+    }
+
+    httplib::Server server;
+    server.new_task_queue = [threads] { return new httplib::ThreadPool(threads); };
+    server.set_tcp_nodelay(true); // 保持连接的客户端一来一回都是小包，不关 Nagle 每次要多等一个延迟确认
+    cout << "Server listening the port " << port << "..." << endl
+         << endl;
+
+    server.Post("/login", login);
+    server.Post("/match", login);        // 配对：和 /login 一样，名字为 body，返回座位号和 Room-ID
+    server.Get("/ready", ready);
+    server.Post("/message", message);
+    server.Get("/turn", get_turn);
+    server.Get("/messages",get_messages);
+    server.Get("/wait", wait_message);   // 长轮询：代替客户端每 1.5 秒查一次 /turn 和 /messages
+    server.Get("/moves", get_moves);     // 第 N 步之后的所有着法，马上返回
+    server.Get("/archive", get_archive); // 查存档：按玩家名字和日期
+    server.Get("/stats", get_stats);     // 房间数、等待配对的人数、着法检查的次数和平均耗时、存档局数（压力测试用）
+
+    server.listen("0.0.0.0", port); // 所有设备都可以连接此电脑
+    return 0;
+}
+
+
+
+//--------------------------------函数体---------------------------------------------------------------------
+
+// 不带符号的十进制数；空的、有别的字符或者太长（会溢出）都返回 false，不像 stoi 那样抛异常
+bool parse_number(const string &text, long long &value)
+{
+    if (text.empty() || text.size() > 18 || text.find_first_not_of("0123456789") != string::npos)
+        return false;
+    value = stoll(text);
+    return true;
+}
+
+// 下棋的请求必须带 Client-ID（座位号 1 / 2）：没带或者不对回 400，返回 false
+bool request_client_id(const httplib::Request &req, httplib::Response &res, int &client_id)
+{
+    long long value;
+    if (!parse_number(req.get_header_value("Client-ID"), value) || value < 1 || value > 2)
+    {
+        res.status = 400;
+        res.set_content("Bad Client-ID.", "text/plain");
+        return false;
+    }
+    client_id = (int)value;
+    return true;
+}
+
+// 可选的数字参数 / 请求头：没给 value 不变；给了但不是不超过 max 的数字回 400，返回 false
+bool optional_number(bool present, const string &text, const char *name, long long max, httplib::Response &res, long long &value)
+{
+    if (!present)
+        return true;
+    if (parse_number(text, value) && value <= max)
+        return true;
+    res.status = 400;
+    res.set_content(string("Bad ") + name + ".", "text/plain");
+    return false;
+}
+
+bool number_param(const httplib::Request &req, httplib::Response &res, const char *name, long long max, long long &value)
+{
+    return optional_number(req.has_param(name), req.get_param_value(name), name, max, res, value);
+}
+
+bool number_header(const httplib::Request &req, httplib::Response &res, const char *name, long long max, long long &value)
+{
+    return optional_number(req.has_header(name), req.get_header_value(name), name, max, res, value);
+}
+
+// 按请求头 Room-ID 找房间，找不到就回 404；没带 Room-ID 的旧客户端当作 1 号房间
+shared_ptr<Match> request_match(const httplib::Request &req, httplib::Response &res)
+{
+    long long room_id = 1;
+    if (!number_header(req, res, "Room-ID", INT_MAX, room_id))
+        return nullptr;
+    shared_ptr<Match> match = FindMatch((int)room_id);
+    if (!match)
+    {
+        res.status = 404;
+        res.set_content("No such room.", "text/plain");
+    }
+    else if (req.has_header("Client-ID")) // 只有玩家的请求算活动，观战的一直看也不会把没人下的房间留着
+    {
+        TouchMatch(*match);
+    }
+    return match;
+}
+
+void login(const httplib::Request &req, httplib::Response &res)
+{
+    string username = req.body; // 1.从client获取名字
+
+    Seat seat = JoinMatch(username); // 2.配对：坐到等人的房间里，或者开一个新房间
+
+    res.set_header("Room-ID", to_string(seat.roomId));
+    res.set_content(to_string(seat.seat), "text/plain"); // 返回座位号（1 / 2），和原来的 ID 一样
+
+    cout << "Client " << seat.seat << " [" << username << "] joined room " << seat.roomId << " from " << req.remote_addr << endl;
+}
+
+void ready(const httplib::Request &req, httplib::Response &res) // 向用户输出需要等待还是开始
+{
+    int client_id;
+    if (!request_client_id(req, res, client_id))
+        return;
+    shared_ptr<Match> match = request_match(req, res);
+    if (!match)
+        return;
+
+    lock_guard<mutex> lock(match->mutex);
+    if (match->players < 2)
+    {
+        res.set_content("Waiting", "text/plain"); // client基于waiting这个字来等待opponent名字准没准备好
+    }
+    else
+    {
+        res.set_content(match->names[client_id == 1 ? 1 : 0], "text/plain"); // 对手的名字
+    }
+}
+
+void message(const httplib::Request &req, httplib::Response &res)
+{
+    int client_id; // 根据client发来的ID知道是哪个client
+    if (!request_client_id(req, res, client_id))
+        return;
+    shared_ptr<Match> match = request_match(req, res);
+    if (!match)
+        return;
+
+    // body 是 MOVE_PACKET_BYTES 字节的二进制着法（着法编码 + 序号）
+    switch (PlayMove(*match, client_id, req.body))
+    {
+    case MOVE_ACCEPTED: // TCP 长连接上的对手和观战的人由 PlayMove 通知
+    case MOVE_RESENT:   // 已经收过了，照常回复
+        break;
+    case MOVE_NOT_YOUR_TURN:
+        res.set_content("Not your turn to send message.", "text/plain");
+        return;
+    case MOVE_BAD_PACKET:
+        res.status = 400;
+        res.set_content("Bad move packet.", "text/plain");
+        return;
+    case MOVE_OUT_OF_SEQUENCE:
+        res.status = 409;
+        res.set_content("Out of sequence.", "text/plain");
+        return;
+    case MOVE_GAME_OVER:
+        res.status = 403;
+        res.set_content("Game over.", "text/plain");
+        return;
+    case MOVE_ILLEGAL:
+        res.status = 403;
+        res.set_content("Illegal move.", "text/plain");
+        return;
+    }
+
+    lock_guard<mutex> lock(match->mutex);
+    res.set_content(to_string(match->turn), "text/plain"); // 返回更新后的回合
+}
+
+void get_turn(const httplib::Request &req, httplib::Response &res) // 发送当前回合
+{
+    shared_ptr<Match> match = request_match(req, res);
+    if (!match)
+        return;
+    lock_guard<mutex> lock(match->mutex);
+    res.set_content(to_string(match->turn), "text/plain");
+}
+
+void get_messages(const httplib::Request &req, httplib::Response &res)
+{
+    shared_ptr<Match> match = request_match(req, res);
+    if (!match)
+        return;
+    lock_guard<mutex> lock(match->mutex); // 加锁保护着法日志
+
+    if (match->moveCount > 0)
+    {
+        // 只返回最新的着法
+        res.set_content(match->moveLog.substr((match->moveCount - 1) * MOVE_PACKET_BYTES), "application/octet-stream");
+    }
+    else
+    {
+        res.set_content("No messages yet.", "text/plain"); // 处理空消息历史记录
+    }
+}
+
+// 回复第 since 步之后的所有着法（按顺序拼在一起），响应头 Message-Count = 总步数，Turn = 当前回合，
+// 下完以后再加 Winner = 胜方座位（和棋是 0）；顺便记下这个座位已经收到了 since 步（调用方持有 match.mutex）
+void reply_moves(Match &match, int client_id, size_t since, httplib::Response &res)
+{
+    since = min(since, (size_t)match.moveCount);
+    if (client_id == 1 || client_id == 2)
+    {
+        match.acked[client_id - 1] = max(match.acked[client_id - 1], (int)since);
+    }
+
+    res.set_header("Message-Count", to_string(match.moveCount));
+    res.set_header("Turn", to_string(match.turn));
+    if (match.finished)
+    {
+        res.set_header("Winner", to_string(Winner(match.state) + 1));
+    }
+    res.set_content(match.moveLog.substr(since * MOVE_PACKET_BYTES), "application/octet-stream");
+}
+
+// 有第 since + 1 步、下完了、或者已经轮到这个客户端（调用方持有 match.mutex）
+bool wait_done(const Match &match, int client_id, size_t since)
+{
+    return (size_t)match.moveCount > since || match.finished || (match.players == 2 && match.turn == client_id);
+}
+
+// 长轮询：GET /wait?since=N，N = 客户端已经看过的步数（包括自己走的）
+// 有第 N + 1 步、或者已经轮到这个客户端时马上返回，否则挂起直到对手走棋（最多 LONG_POLL_SECONDS 秒）
+// 返回第 N 步之后的所有着法，客户端不管漏了几步，一次就能补上
+void wait_message(const httplib::Request &req, httplib::Response &res)
+{
+    long long client_id = 0, since = 0;
+    if (!number_header(req, res, "Client-ID", INT_MAX, client_id) || !number_param(req, res, "since", INT_MAX, since))
+        return;
+    shared_ptr<Match> match = request_match(req, res);
+    if (!match)
+        return;
+
+    unique_lock<mutex> lock(match->mutex);
+    match->cv.wait_for(lock, chrono::seconds(LONG_POLL_SECONDS), [&]
+                       { return wait_done(*match, client_id, since); });
+    reply_moves(*match, client_id, since, res);
+}
+
+// epoll 后端的 /wait：条件满足（或者 timed_out）就和 wait_message 一样回复，返回 true；否则什么都不做，等房间有变化再问
+bool poll_wait_message(const httplib::Request &req, httplib::Response &res, bool timed_out)
+{
+    long long client_id = 0, since = 0;
+    if (!number_header(req, res, "Client-ID", INT_MAX, client_id) || !number_param(req, res, "since", INT_MAX, since))
+        return true;
+    shared_ptr<Match> match = request_match(req, res);
+    if (!match)
+        return true;
+
+    lock_guard<mutex> lock(match->mutex);
+    if (!timed_out && !wait_done(*match, client_id, since))
+        return false;
+    reply_moves(*match, client_id, since, res);
+    return true;
+}
+
+// GET /moves?since=N：和 /wait 一样的回复，但不等待
+void get_moves(const httplib::Request &req, httplib::Response &res)
+{
+    long long client_id = 0, since = 0;
+    if (!number_header(req, res, "Client-ID", INT_MAX, client_id) || !number_param(req, res, "since", INT_MAX, since))
+        return;
+    shared_ptr<Match> match = request_match(req, res);
+    if (!match)
+        return;
+
+    lock_guard<mutex> lock(match->mutex);
+    reply_moves(*match, client_id, since, res);
+}
+
+void get_stats(const httplib::Request &, httplib::Response &res)
+{
+    long long moves = validatedMoves.load();
+    string stats = "matches " + to_string(MatchCount()) + "\nwaiting " + to_string(WaitingPlayers()) + "\n";
+    stats += "moves_validated " + to_string(moves) + "\nillegal_moves " + to_string(illegalMoves.load()) + "\n";
+    stats += "validate_ns_avg " + to_string(moves > 0 ? validateNs.load() / moves : 0) + "\n";
+    stats += "streams " + to_string(StreamConnections()) + "\n";
+    stats += "epoll_connections " + to_string(EpollConnections()) + "\nepoll_parked " + to_string(EpollParked()) + "\n";
+    stats += "archived " + to_string(ArchivedGames()) + "\n";
+    res.set_content(stats, "text/plain");
+}
+
+// YYYYMMDD（UTC）-> 那一天 0 点的 Unix 秒
+int64_t day_start(int date)
+{
+    int year = date / 10000, month = date / 100 % 100, day = date % 100;
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int year_of_era = year - era * 400;
+    int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return ((int64_t)era * 146097 + day_of_era - 719468) * 86400;
+}
+
+// GET /archive?player=名字&from=YYYYMMDD&to=YYYYMMDD&limit=N，参数都可以不给；to 那一天也算
+// 每局一行：编号 结束时间 白方 黑方 胜方座位（和棋 0） 步数 着法（m14 h35 ...）
+void get_archive(const httplib::Request &req, httplib::Response &res)
+{
+    ArchiveQuery query;
+    query.player = req.has_param("player") ? req.get_param_value("player") : "";
+    long long from = 0, to = 0, limit = ARCHIVE_LIMIT;
+    if (!number_param(req, res, "from", 99991231, from) || !number_param(req, res, "to", 99991231, to) || !number_param(req, res, "limit", INT_MAX, limit))
+        return;
+    query.from = req.has_param("from") ? day_start((int)from) : 0;
+    query.to = req.has_param("to") ? day_start((int)to) + 86400 : 0;
+    query.limit = (int)limit;
+
+    vector<ArchivedGame> games;
+    QueryArchive(query, games);
+
+    string body;
+    for (const ArchivedGame &game : games)
+    {
+        time_t end = (time_t)game.endTime;
+        tm utc;
+        gmtime_r(&end, &utc);
+        char date[32];
+        strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &utc);
+
+        body += to_string(game.id) + " " + date + " " + game.names[0] + " " + game.names[1] + " " + to_string(game.winner) + " " + to_string(game.moves.size());
+        for (uint8_t code : game.moves)
+        {
+            Move move;
+            char text[4] = "?";
+            if (DecodeMoveCode(code, move))
+            {
+                FormatMove(move, text);
+            }
+            body += " ";
+            body += text;
+        }
+        body += "\n";
+    }
+    res.set_content(body, "text/plain");
+}
@@ -0,0 +1,308 @@
+#include "archive.h"
+#include "game_state.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
+#include <shared_mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+const size_t MAP_CHUNK = (size_t)64 << 20; // 映射按 64 MB 一块往上留余量，文件变长时不用每次重新映射
+
+struct PendingGame // 写入队列里的一局，已经编码成文件里的记录
+{
+    std::string record;
+};
+
+// 写入队列：走棋的线程放进去，写线程取出来
+std::mutex queueMutex;
+std::condition_variable queueCv;
+std::condition_variable drainedCv;
+std::deque<PendingGame> pendingGames;
+bool writing = false; // 写线程手里有一批还没建好索引
+bool stopping = false;
+std::thread writerThread;
+
+// 文件和索引：查询用共享锁，写线程追加索引和重新映射时用独占锁
+std::shared_mutex indexMutex;
+int archiveFd = -1;
+const uint8_t *mapped = nullptr;
+size_t mappedCapacity = 0;     // 映射的长度（可以超过文件长度，超出的部分不会去读）
+size_t fileSize = 0;           // 已经写进文件并建好索引的字节数
+int64_t lastEndTime = 0;       // 最后一局的结束时间
+std::vector<uint64_t> offsets; // 每一局记录的偏移，按时间顺序
+std::unordered_map<std::string, std::vector<uint32_t>> byPlayer; // 玩家名字 -> 他下过的对局（offsets 的下标，按时间顺序）
+
+static ArchiveHeader HeaderAt(uint64_t offset) // 记录不一定对齐，拷出来再读
+{
+    ArchiveHeader header;
+    memcpy(&header, mapped + offset, sizeof(header));
+    return header;
+}
+
+static bool MapArchive(size_t size) // 调用方持有 indexMutex 独占锁
+{
+    size_t capacity = (size / MAP_CHUNK + 1) * MAP_CHUNK;
+    if (mapped && capacity <= mappedCapacity)
+        return true;
+    if (mapped)
+        munmap((void *)mapped, mappedCapacity);
+    void *address = mmap(nullptr, capacity, PROT_READ, MAP_SHARED, archiveFd, 0);
+    if (address == MAP_FAILED)
+    {
+        mapped = nullptr;
+        mappedCapacity = 0;
+        return false;
+    }
+    mapped = (const uint8_t *)address;
+    mappedCapacity = capacity;
+    return true;
+}
+
+static void IndexRecord(uint64_t offset) // 调用方持有 indexMutex 独占锁
+{
+    ArchiveHeader header = HeaderAt(offset);
+    const char *names = (const char *)(mapped + offset + sizeof(ArchiveHeader));
+    uint32_t game = (uint32_t)offsets.size();
+    offsets.push_back(offset);
+    byPlayer[std::string(names, header.nameLength[0])].push_back(game);
+    if (header.nameLength[1] != header.nameLength[0] || memcmp(names, names + header.nameLength[0], header.nameLength[0]) != 0)
+        byPlayer[std::string(names + header.nameLength[0], header.nameLength[1])].push_back(game);
+    lastEndTime = header.endTime;
+}
+
+static void WriterThread()
+{
+    int64_t writerEndTime = lastEndTime;
+    while (true)
+    {
+        std::deque<PendingGame> batch;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCv.wait(lock, []
+                         { return !pendingGames.empty() || stopping; });
+            if (pendingGames.empty())
+                return;
+            batch.swap(pendingGames);
+            writing = true;
+        }
+
+        // 一批拼成一次 write；出错就丢掉这一批（存档不影响对局本身）
+        // 几个线程同时下完时入队顺序和取时间的顺序可能差一点，这里保证结束时间不倒退
+        std::string buffer;
+        for (PendingGame &game : batch)
+        {
+            ArchiveHeader header;
+            memcpy(&header, game.record.data(), sizeof(header));
+            header.endTime = std::max(header.endTime, writerEndTime);
+            writerEndTime = header.endTime;
+            memcpy(&game.record[0], &header, sizeof(header));
+            buffer += game.record;
+        }
+        size_t written = 0;
+        while (written < buffer.size())
+        {
+            ssize_t n = write(archiveFd, buffer.data() + written, buffer.size() - written);
+            if (n <= 0)
+                break;
+            written += (size_t)n;
+        }
+
+        if (written == buffer.size())
+        {
+            std::unique_lock<std::shared_mutex> lock(indexMutex);
+            if (MapArchive(fileSize + buffer.size()))
+            {
+                uint64_t offset = fileSize;
+                fileSize += buffer.size();
+                for (const PendingGame &game : batch)
+                {
+                    IndexRecord(offset);
+                    offset += game.record.size();
+                }
+            }
+        }
+        else if (ftruncate(archiveFd, (off_t)fileSize) == 0) // 写了一半：截回去，下次接着写
+            lseek(archiveFd, 0, SEEK_END);
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            writing = false;
+        }
+        drainedCv.notify_all();
+    }
+}
+
+bool OpenArchive(const std::string &path)
+{
+    archiveFd = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (archiveFd < 0)
+        return false;
+    struct stat st;
+    if (fstat(archiveFd, &st) != 0)
+        return false;
+
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    size_t size = (size_t)st.st_size;
+    if (!MapArchive(size))
+        return false;
+
+    // 沿着记录头走一遍建索引，遇到不完整的记录（上次写到一半退出）就截掉
+    uint64_t offset = 0;
+    while (offset + sizeof(ArchiveHeader) <= size)
+    {
+        ArchiveHeader header = HeaderAt(offset);
+        size_t minimum = sizeof(ArchiveHeader) + header.nameLength[0] + header.nameLength[1] + header.moveCount;
+        if (header.magic != ARCHIVE_MAGIC || header.length < minimum || offset + header.length > size)
+            break;
+        IndexRecord(offset);
+        offset += header.length;
+    }
+    if (offset != size && ftruncate(archiveFd, (off_t)offset) != 0)
+        return false;
+    fileSize = offset;
+
+    writerThread = std::thread(WriterThread);
+    return true;
+}
+
+void CloseArchive()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCv.notify_all();
+    if (writerThread.joinable())
+        writerThread.join();
+
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    if (mapped)
+        munmap((void *)mapped, mappedCapacity);
+    if (archiveFd >= 0)
+        close(archiveFd);
+    archiveFd = -1;
+    mapped = nullptr;
+    mappedCapacity = fileSize = 0;
+    lastEndTime = 0;
+    offsets.clear();
+    byPlayer.clear();
+    stopping = false;
+}
+
+void ArchiveMatch(const std::string names[2], int winner, const std::string &moveLog, int moveCount, int64_t endTime)
+{
+    if (archiveFd < 0)
+        return;
+
+    PendingGame game;
+    std::string shortNames[2];
+    ArchiveHeader header = {};
+    header.magic = ARCHIVE_MAGIC;
+    header.endTime = endTime;
+    header.winner = (uint8_t)winner;
+    for (int s = 0; s < 2; s++)
+    {
+        shortNames[s] = names[s].substr(0, 255);
+        header.nameLength[s] = (uint8_t)shortNames[s].size();
+    }
+    header.moveCount = (uint16_t)moveCount;
+    header.length = (uint32_t)(sizeof(ArchiveHeader) + header.nameLength[0] + header.nameLength[1] + moveCount);
+
+    game.record.reserve(header.length);
+    game.record.append((const char *)&header, sizeof(header));
+    game.record += shortNames[0];
+    game.record += shortNames[1];
+    for (int k = 0; k < moveCount; k++)
+        game.record += moveLog[k * MOVE_PACKET_BYTES]; // 只留着法编码，序号就是下标
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pendingGames.push_back(std::move(game));
+    }
+    queueCv.notify_one();
+}
+
+void FlushArchive()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    drainedCv.wait(lock, []
+                   { return pendingGames.empty() && !writing; });
+}
+
+size_t ArchivedGames()
+{
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+    return offsets.size();
+}
+
+static void ReadGame(uint64_t offset, ArchivedGame &game) // 调用方持有 indexMutex
+{
+    ArchiveHeader header = HeaderAt(offset);
+    const uint8_t *data = mapped + offset + sizeof(ArchiveHeader);
+    game.id = offset;
+    game.endTime = header.endTime;
+    game.winner = header.winner;
+    game.names[0].assign((const char *)data, header.nameLength[0]);
+    game.names[1].assign((const char *)data + header.nameLength[0], header.nameLength[1]);
+    data += header.nameLength[0] + header.nameLength[1];
+    game.moves.assign(data, data + header.moveCount);
+}
+
+size_t QueryArchive(const ArchiveQuery &query, std::vector<ArchivedGame> &games)
+{
+    games.clear();
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+    // 候选对局：某个玩家的列表，或者全部；两者都按时间排好序，用二分找到时间范围
+    const std::vector<uint32_t> *list = nullptr;
+    size_t count = offsets.size();
+    if (!query.player.empty())
+    {
+        auto found = byPlayer.find(query.player);
+        if (found == byPlayer.end())
+            return 0;
+        list = &found->second;
+        count = list->size();
+    }
+    auto endTimeAt = [&](size_t k)
+    { return HeaderAt(offsets[list ? (*list)[k] : k]).endTime; };
+
+    size_t low = 0, high = count;
+    size_t first = 0, last = count;
+    while (low < high) // 第一个 endTime >= from
+    {
+        size_t mid = (low + high) / 2;
+        if (endTimeAt(mid) < query.from)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    first = low;
+    if (query.to > 0)
+    {
+        low = first, high = count;
+        while (low < high) // 第一个 endTime >= to
+        {
+            size_t mid = (low + high) / 2;
+            if (endTimeAt(mid) < query.to)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        last = low;
+    }
+
+    for (size_t k = last; k > first && (int)games.size() < query.limit; k--)
+    {
+        games.emplace_back();
+        ReadGame(offsets[list ? (*list)[k - 1] : k - 1], games.back());
+    }
+    return games.size();
+}
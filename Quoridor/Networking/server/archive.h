@@ -0,0 +1,56 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 对局存档：下完的对局（双方名字、胜负、着法）追加写进一个文件，服务器重启后还在
+// 写文件在后台线程里做，走棋的请求只是把这一局放进队列；读的时候直接读内存映射（mmap）的文件
+// 打开存档时沿着文件走一遍记录头，在内存里建好按玩家名字和按时间的索引，之后查询不用扫描整个文件
+//
+// 文件里一局一条记录：ArchiveHeader + 白方名字 + 黑方名字 + 每步 1 字节的着法编码（EncodeMoveCode）
+// 记录按写入顺序排列，结束时间不会倒退，所以按时间查询可以二分
+
+const uint32_t ARCHIVE_MAGIC = 0x4D414751; // "QGAM"，用来发现写了一半的记录
+
+struct ArchiveHeader
+{
+    uint32_t magic;
+    uint32_t length;       // 整条记录的字节数（包括记录头）
+    int64_t endTime;       // 结束时间（Unix 秒）
+    uint8_t winner;        // 胜方座位 1 / 2，和棋是 0
+    uint8_t nameLength[2]; // 两个名字的字节数（最多 255）
+    uint8_t reserved;
+    uint16_t moveCount;    // 步数
+    uint16_t reserved2;
+};
+
+struct ArchivedGame // 查询结果
+{
+    uint64_t id;         // 记录在文件里的偏移，也是这一局的编号
+    int64_t endTime;
+    int winner;
+    std::string names[2];
+    std::vector<uint8_t> moves; // 着法编码
+};
+
+struct ArchiveQuery
+{
+    std::string player; // 空 = 不限玩家
+    int64_t from;       // 结束时间范围 [from, to)（Unix 秒），to <= 0 表示不限
+    int64_t to;
+    int limit;          // 最多返回几局（从最新的开始）
+};
+
+bool OpenArchive(const std::string &path); // 打开（没有就新建）、建索引、启动写线程；截掉末尾写了一半的记录
+void CloseArchive();                       // 写完队列里剩下的对局，停掉写线程，关掉文件
+
+// 把一局放进写入队列，马上返回；moveLog 是服务器的着法日志（每步 MOVE_PACKET_BYTES 字节），endTime 是 Unix 秒
+void ArchiveMatch(const std::string names[2], int winner, const std::string &moveLog, int moveCount, int64_t endTime);
+void FlushArchive(); // 等队列里的对局都写进文件并建好索引
+
+size_t ArchivedGames();                                                           // 已经写进文件的对局数
+size_t QueryArchive(const ArchiveQuery &query, std::vector<ArchivedGame> &games); // 按玩家和时间查，新的在前
+
+#endif
@@ -0,0 +1,532 @@
+#include "epoll_server.h"
+#include "match.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+const size_t MAX_REQUEST_BYTES = 64 * 1024; // 一个请求（请求头 + body）或者攒着没处理的输入超过这么长就断开
+const size_t READ_CHUNK = 16 * 1024;
+const int EPOLL_BATCH = 256;
+const int TICK_MS = 1000; // 每秒查一次挂起的请求有没有超时
+const uint64_t WAKE_EVENT = ~0ULL; // eventfd 的 epoll_event.data（连接的 fd 不会是 -1）
+
+using Clock = std::chrono::steady_clock;
+
+struct EpollConnection
+{
+    int fd;
+    uint64_t generation;                // fd 会被复用，唤醒时用它认出是不是还是同一个连接
+    std::string in;                     // 读到还没处理的字节
+    std::string out;                    // 还没写出去的回复
+    std::string remoteAddr;             // 对方 IP（登录日志用，和 httplib 的 req.remote_addr 一样）
+    bool writing = false;               // 已经在 epoll 里等可写
+    bool closeAfterWrite = false;       // Connection: close，写完就关
+    bool parked = false;                // 有一个请求挂着
+    httplib::Request request;           // 挂着的请求
+    const EpollRoute *route = nullptr;
+    Clock::time_point deadline;         // 挂到什么时候必须回复
+};
+
+struct ParkedRef // 挂在某个房间上的连接
+{
+    int worker;
+    int fd;
+    uint64_t generation;
+};
+
+struct EpollWorker
+{
+    int epfd;
+    int wakeFd;                                    // eventfd：别的线程叫这个线程看看 woken / accepted 里的连接
+    std::mutex wokenMutex;
+    std::vector<ParkedRef> woken;
+    std::vector<std::unique_ptr<EpollConnection>> accepted; // 接受线程新建好的连接，由这个线程自己登记到 epoll
+    std::unordered_map<int, std::unique_ptr<EpollConnection>> connections; // 只有这个线程自己碰
+};
+
+std::vector<std::unique_ptr<EpollWorker>> epollWorkers;
+const std::vector<EpollRoute> *routeTable = nullptr;
+int waitTimeoutSeconds = 25;
+std::atomic<uint64_t> nextGeneration(1);
+std::atomic<size_t> epollConnectionCount(0);
+std::atomic<size_t> epollParkedCount(0);
+
+// 房间号 -> 挂在这个房间上的连接；房间有变化时整张列表取走，挂着的连接重新判断，还不能回复的再挂回来
+std::mutex parkedMutex;
+std::unordered_map<int, std::vector<ParkedRef>> parkedByRoom;
+
+size_t EpollConnections()
+{
+    return epollConnectionCount.load();
+}
+
+size_t EpollParked()
+{
+    return epollParkedCount.load();
+}
+
+// epoll_event.data 里放 fd 和代数的低 32 位：同一批事件里连接被关掉、fd 又被复用时，旧事件对不上代数会被跳过
+static uint64_t EventData(const EpollConnection &conn)
+{
+    return ((uint64_t)(uint32_t)conn.fd << 32) | (uint32_t)conn.generation;
+}
+
+static void WakeWorker(EpollWorker &worker)
+{
+    uint64_t one = 1;
+    ssize_t written = write(worker.wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+static void WakeRoom(int roomId) // MatchListener
+{
+    std::vector<ParkedRef> refs;
+    {
+        std::lock_guard<std::mutex> lock(parkedMutex);
+        auto found = parkedByRoom.find(roomId);
+        if (found == parkedByRoom.end())
+            return;
+        refs.swap(found->second);
+        parkedByRoom.erase(found);
+    }
+    std::vector<bool> touched(epollWorkers.size(), false);
+    for (const ParkedRef &ref : refs)
+    {
+        EpollWorker &worker = *epollWorkers[ref.worker];
+        std::lock_guard<std::mutex> lock(worker.wokenMutex);
+        worker.woken.push_back(ref);
+        touched[ref.worker] = true;
+    }
+    for (size_t w = 0; w < touched.size(); w++)
+    {
+        if (touched[w])
+            WakeWorker(*epollWorkers[w]);
+    }
+}
+
+static int RequestRoom(const httplib::Request &req) // 和 server.cpp 的 request_match 一样，没带 Room-ID 当作 1 号房间
+{
+    return req.has_header("Room-ID") ? atoi(req.get_header_value("Room-ID").c_str()) : 1;
+}
+
+static void Park(int worker, EpollConnection &conn)
+{
+    std::lock_guard<std::mutex> lock(parkedMutex);
+    parkedByRoom[RequestRoom(conn.request)].push_back({worker, conn.fd, conn.generation});
+}
+
+// 连接不再挂着（回复了或者关了）：把它从房间的列表里拿掉，房间以后没有变化（下完了、被清理了）也不会留下
+static void Unpark(int worker, EpollConnection &conn)
+{
+    std::lock_guard<std::mutex> lock(parkedMutex);
+    auto found = parkedByRoom.find(RequestRoom(conn.request));
+    if (found == parkedByRoom.end())
+        return; // 已经被 WakeRoom 整张取走了
+    std::vector<ParkedRef> &refs = found->second;
+    for (size_t i = 0; i < refs.size(); i++)
+    {
+        if (refs[i].worker == worker && refs[i].generation == conn.generation)
+        {
+            refs.erase(refs.begin() + i);
+            break;
+        }
+    }
+    if (refs.empty())
+        parkedByRoom.erase(found);
+}
+
+static void CloseConnection(int index, EpollConnection &conn)
+{
+    EpollWorker &worker = *epollWorkers[index];
+    if (conn.parked)
+    {
+        Unpark(index, conn);
+        epollParkedCount--;
+    }
+    epoll_ctl(worker.epfd, EPOLL_CTL_DEL, conn.fd, nullptr);
+    close(conn.fd);
+    epollConnectionCount--;
+    worker.connections.erase(conn.fd); // conn 在这之后不能再用
+}
+
+// 尽量写；写不完就等可写，写完了按需关闭。返回 false = 连接已经关掉
+static bool Flush(int index, EpollConnection &conn)
+{
+    EpollWorker &worker = *epollWorkers[index];
+    size_t written = 0;
+    while (written < conn.out.size())
+    {
+        ssize_t n = send(conn.fd, conn.out.data() + written, conn.out.size() - written, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            written += (size_t)n;
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        CloseConnection(index, conn);
+        return false;
+    }
+    conn.out.erase(0, written);
+
+    if (conn.out.empty() && conn.closeAfterWrite)
+    {
+        CloseConnection(index, conn);
+        return false;
+    }
+    bool wantWrite = !conn.out.empty();
+    if (wantWrite != conn.writing)
+    {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        if (wantWrite)
+            event.events |= EPOLLOUT;
+        event.data.u64 = EventData(conn);
+        epoll_ctl(worker.epfd, EPOLL_CTL_MOD, conn.fd, &event);
+        conn.writing = wantWrite;
+    }
+    return true;
+}
+
+static void AppendResponse(EpollConnection &conn, const httplib::Request &req, const httplib::Response &res)
+{
+    bool keepAlive = req.version != "HTTP/1.0" && req.get_header_value("Connection") != "close";
+    conn.out += "HTTP/1.1 " + std::to_string(res.status) + " " + httplib::status_message(res.status) + "\r\n";
+    for (const auto &header : res.headers)
+        conn.out += header.first + ": " + header.second + "\r\n";
+    conn.out += "Content-Length: " + std::to_string(res.body.size()) + "\r\n";
+    conn.out += keepAlive ? "Connection: Keep-Alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    conn.out += res.body;
+    if (!keepAlive)
+        conn.closeAfterWrite = true;
+}
+
+// 挂着的请求再判断一次：能回复就回复，不能就重新挂到房间上（先挂再判断，判断期间的变化不会漏掉）
+static void Resume(int worker, EpollConnection &conn, bool timedOut)
+{
+    if (!timedOut)
+        Park(worker, conn);
+    httplib::Response res;
+    res.status = 200;
+    try
+    {
+        if (!conn.route->waitHandler(conn.request, res, timedOut))
+            return; // 留在房间的列表里，下次变化再看
+    }
+    catch (const std::exception &) // 和 httplib 一样：处理函数抛异常回 500
+    {
+        res.status = 500;
+        res.body.clear();
+    }
+    Unpark(worker, conn);
+    conn.parked = false;
+    epollParkedCount--;
+    AppendResponse(conn, conn.request, res);
+}
+
+// 一个完整的请求：找路由、处理；可以挂起的请求条件不满足就挂起
+static void Dispatch(int worker, EpollConnection &conn, httplib::Request &req)
+{
+    const EpollRoute *route = nullptr;
+    for (const EpollRoute &candidate : *routeTable)
+    {
+        if (candidate.method == req.method && candidate.path == req.path)
+        {
+            route = &candidate;
+            break;
+        }
+    }
+    httplib::Response res;
+    res.status = 200;
+    if (!route)
+    {
+        res.status = 404;
+        AppendResponse(conn, req, res);
+        return;
+    }
+    if (route->handler)
+    {
+        try
+        {
+            route->handler(req, res);
+        }
+        catch (const std::exception &)
+        {
+            res.status = 500;
+            res.body.clear();
+        }
+        AppendResponse(conn, req, res);
+        return;
+    }
+
+    conn.request = std::move(req);
+    conn.route = route;
+    conn.parked = true;
+    conn.deadline = Clock::now() + std::chrono::seconds(waitTimeoutSeconds);
+    epollParkedCount++;
+    Resume(worker, conn, false);
+}
+
+// 解析 conn.in 里完整的请求并处理（挂起时停下，后面的请求等它回复以后再处理）。返回 false = 请求不合法，要断开
+static bool ProcessRequests(int worker, EpollConnection &conn)
+{
+    while (!conn.parked && !conn.closeAfterWrite)
+    {
+        size_t headerEnd = conn.in.find("\r\n\r\n");
+        if (headerEnd == std::string::npos)
+            return conn.in.size() <= MAX_REQUEST_BYTES;
+
+        httplib::Request req;
+        req.remote_addr = conn.remoteAddr;
+        size_t lineEnd = conn.in.find("\r\n");
+        std::string line = conn.in.substr(0, lineEnd);
+        size_t space1 = line.find(' '), space2 = line.rfind(' ');
+        if (space1 == std::string::npos || space2 == space1)
+            return false;
+        req.method = line.substr(0, space1);
+        req.target = line.substr(space1 + 1, space2 - space1 - 1);
+        req.version = line.substr(space2 + 1);
+        size_t question = req.target.find('?');
+        req.path = req.target.substr(0, question);
+        if (question != std::string::npos)
+            httplib::detail::parse_query_text(req.target.substr(question + 1), req.params);
+
+        for (size_t pos = lineEnd + 2; pos < headerEnd;)
+        {
+            size_t end = conn.in.find("\r\n", pos);
+            size_t colon = conn.in.find(':', pos);
+            if (colon != std::string::npos && colon < end)
+            {
+                size_t value = conn.in.find_first_not_of(' ', colon + 1);
+                value = value > end ? end : value;
+                req.headers.emplace(conn.in.substr(pos, colon - pos), conn.in.substr(value, end - value));
+            }
+            pos = end + 2;
+        }
+
+        size_t length = req.has_header("Content-Length") ? (size_t)atoll(req.get_header_value("Content-Length").c_str()) : 0;
+        if (headerEnd + 4 + length > MAX_REQUEST_BYTES)
+            return false;
+        if (conn.in.size() < headerEnd + 4 + length)
+            return true; // body 还没收全
+        req.body = conn.in.substr(headerEnd + 4, length);
+        conn.in.erase(0, headerEnd + 4 + length);
+        Dispatch(worker, conn, req);
+    }
+    return true;
+}
+
+// 挂着的请求回复了：处理它后面已经收到的请求，然后发出去
+static void ContinueConnection(int worker, EpollConnection &conn)
+{
+    if (ProcessRequests(worker, conn))
+        Flush(worker, conn);
+    else
+        CloseConnection(worker, conn);
+}
+
+static void ReadConnection(int worker, EpollConnection &conn)
+{
+    char chunk[READ_CHUNK];
+    while (true)
+    {
+        ssize_t n = recv(conn.fd, chunk, sizeof(chunk), 0);
+        if (n > 0)
+        {
+            conn.in.append(chunk, (size_t)n);
+            // 挂起或者等着发完关闭的时候 ProcessRequests 不往下解析，对方一直发就会一直攒：先把能处理的处理掉，还超过上限就断开
+            if (conn.in.size() > MAX_REQUEST_BYTES && (!ProcessRequests(worker, conn) || conn.in.size() > MAX_REQUEST_BYTES))
+            {
+                CloseConnection(worker, conn);
+                return;
+            }
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        CloseConnection(worker, conn); // 对方关了或者出错
+        return;
+    }
+    if (!ProcessRequests(worker, conn))
+    {
+        CloseConnection(worker, conn);
+        return;
+    }
+    Flush(worker, conn);
+}
+
+// 事件对应的连接；连接已经关了（fd 可能已经给了别的连接或者别的线程）返回 nullptr
+static EpollConnection *ConnectionFor(EpollWorker &worker, uint64_t data)
+{
+    auto found = worker.connections.find((int)(data >> 32));
+    if (found == worker.connections.end() || (uint32_t)found->second->generation != (uint32_t)data)
+        return nullptr;
+    return found->second.get();
+}
+
+static void WorkerLoop(int index)
+{
+    EpollWorker &worker = *epollWorkers[index];
+    epoll_event events[EPOLL_BATCH];
+    Clock::time_point nextTick = Clock::now() + std::chrono::milliseconds(TICK_MS);
+    while (true)
+    {
+        int n = epoll_wait(worker.epfd, events, EPOLL_BATCH, TICK_MS);
+        for (int i = 0; i < n; i++)
+        {
+            if (events[i].data.u64 == WAKE_EVENT) // 唤醒：新连接登记进来，房间有变化的挂着的连接再判断一次
+            {
+                uint64_t count;
+                ssize_t got = read(worker.wakeFd, &count, sizeof(count));
+                (void)got;
+                std::vector<ParkedRef> woken;
+                std::vector<std::unique_ptr<EpollConnection>> accepted;
+                {
+                    std::lock_guard<std::mutex> lock(worker.wokenMutex);
+                    woken.swap(worker.woken);
+                    accepted.swap(worker.accepted);
+                }
+                for (std::unique_ptr<EpollConnection> &conn : accepted)
+                {
+                    epoll_event event = {};
+                    event.events = EPOLLIN;
+                    event.data.u64 = EventData(*conn);
+                    int fd = conn->fd;
+                    worker.connections[fd] = std::move(conn);
+                    epoll_ctl(worker.epfd, EPOLL_CTL_ADD, fd, &event);
+                }
+                for (const ParkedRef &ref : woken)
+                {
+                    auto found = worker.connections.find(ref.fd);
+                    if (found == worker.connections.end() || found->second->generation != ref.generation || !found->second->parked)
+                        continue;
+                    EpollConnection &conn = *found->second;
+                    Resume(index, conn, false);
+                    if (!conn.parked)
+                        ContinueConnection(index, conn);
+                }
+                continue;
+            }
+
+            EpollConnection *conn = ConnectionFor(worker, events[i].data.u64);
+            if (!conn) // 这一批前面的事件已经把它关掉了
+                continue;
+            if (events[i].events & (EPOLLERR | EPOLLHUP))
+            {
+                CloseConnection(index, *conn);
+                continue;
+            }
+            if (events[i].events & EPOLLIN)
+            {
+                ReadConnection(index, *conn);
+                if (!ConnectionFor(worker, events[i].data.u64))
+                    continue;
+            }
+            if (events[i].events & EPOLLOUT)
+                Flush(index, *conn);
+        }
+
+        Clock::time_point now = Clock::now();
+        if (now < nextTick)
+            continue;
+        nextTick = now + std::chrono::milliseconds(TICK_MS);
+        std::vector<int> expired;
+        for (auto &entry : worker.connections)
+        {
+            if (entry.second->parked && entry.second->deadline <= now)
+                expired.push_back(entry.first);
+        }
+        for (int fd : expired) // 挂满 waitSeconds：按当前状态回复，客户端会再发一次
+        {
+            EpollConnection &conn = *worker.connections[fd];
+            Resume(index, conn, true);
+            ContinueConnection(index, conn);
+        }
+    }
+}
+
+bool RunEpollServer(int port, int workers, const std::vector<EpollRoute> &routes, int waitSeconds)
+{
+    // 每个连接一个 fd：把打开文件数的上限提到系统允许的最大值
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0)
+        return false;
+    int yes = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)port);
+    if (bind(listener, (sockaddr *)&address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+    {
+        close(listener);
+        return false;
+    }
+
+    routeTable = &routes;
+    waitTimeoutSeconds = waitSeconds;
+    for (int w = 0; w < workers; w++)
+    {
+        std::unique_ptr<EpollWorker> worker(new EpollWorker());
+        worker->epfd = epoll_create1(0);
+        worker->wakeFd = eventfd(0, EFD_NONBLOCK);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = WAKE_EVENT;
+        epoll_ctl(worker->epfd, EPOLL_CTL_ADD, worker->wakeFd, &event);
+        epollWorkers.push_back(std::move(worker));
+    }
+    AddMatchListener(WakeRoom);
+    for (int w = 0; w < workers; w++)
+        std::thread(WorkerLoop, w).detach();
+
+    // 接受连接，轮流分给各个工作线程（连接之后一直由同一个线程处理）
+    for (int next = 0;; next = (next + 1) % workers)
+    {
+        int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK);
+        if (fd < 0)
+        {
+            if (errno == EMFILE || errno == ENFILE) // fd 用完了：等一会儿，别空转
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        epollConnectionCount++;
+
+        // 连接对象在这里建好交给工作线程，由它自己登记到 epoll（epoll 里的 fd 一定在它的 connections 里）
+        std::unique_ptr<EpollConnection> conn(new EpollConnection());
+        conn->fd = fd;
+        conn->generation = nextGeneration++;
+        sockaddr_in peer = {};
+        socklen_t length = sizeof(peer);
+        char text[INET_ADDRSTRLEN] = "";
+        if (getpeername(fd, (sockaddr *)&peer, &length) == 0)
+            inet_ntop(AF_INET, &peer.sin_addr, text, sizeof(text));
+        conn->remoteAddr = text;
+
+        EpollWorker &worker = *epollWorkers[next];
+        {
+            std::lock_guard<std::mutex> lock(worker.wokenMutex);
+            worker.accepted.push_back(std::move(conn));
+        }
+        WakeWorker(worker);
+    }
+}
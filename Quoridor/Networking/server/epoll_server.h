@@ -0,0 +1,31 @@
+#ifndef EPOLL_SERVER_H
+#define EPOLL_SERVER_H
+
+#include "../thirdparty/httplib.h"
+#include <string>
+#include <vector>
+
+// epoll 后端（./server --epoll）：和 httplib 后端一样的 HTTP 接口和处理函数，但不是一个连接占一个线程
+// 固定几个工作线程，每个线程一个 epoll，所有连接都是非阻塞的；请求处理完马上回复
+// 长轮询（/wait）条件不满足时连接只是挂起（不占线程），房间有变化（MatchListener）或者超时再处理一次
+// 所以在线但空闲的玩家（等对手、挂着 /wait）只花一个连接对象和一个 socket 的内存
+
+typedef void (*EpollHandler)(const httplib::Request &req, httplib::Response &res);
+// 可以挂起的请求：返回 false 表示现在还不能回复；timedOut = true 时必须回复
+typedef bool (*EpollWaitHandler)(const httplib::Request &req, httplib::Response &res, bool timedOut);
+
+struct EpollRoute
+{
+    std::string method;
+    std::string path;
+    EpollHandler handler;         // 马上回复的请求
+    EpollWaitHandler waitHandler; // 或者可以挂起的请求（两个只给一个）
+};
+
+// 在当前线程里接受连接，不返回；端口打不开返回 false。挂起的请求最多等 waitSeconds 秒
+bool RunEpollServer(int port, int workers, const std::vector<EpollRoute> &routes, int waitSeconds);
+
+size_t EpollConnections(); // 当前连接数
+size_t EpollParked();      // 当前挂起的请求数
+
+#endif
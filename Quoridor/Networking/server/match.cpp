@@ -0,0 +1,198 @@
+#include "match.h"
+#include "archive.h"
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+// 房间表：查房间（每个请求都要查）用共享锁，只有开新房间时才用独占锁
+std::unordered_map<int, std::shared_ptr<Match>> matches;
+std::shared_mutex tableMutex;
+
+// 配对大厅：等对手的房间 + 名字到座位的映射，只在登录时用到
+std::mutex lobbyMutex;
+std::shared_ptr<Match> waitingMatch;
+std::unordered_map<std::string, Seat> seats;
+int nextRoomId = 1;
+
+std::atomic<long long> validatedMoves(0);
+std::atomic<long long> illegalMoves(0);
+std::atomic<long long> validateNs(0);
+
+std::vector<MatchListener> listeners; // 启动时注册完，之后只读
+
+void AddMatchListener(MatchListener listener)
+{
+    listeners.push_back(listener);
+}
+
+static void NotifyListeners(int roomId)
+{
+    for (MatchListener listener : listeners)
+        listener(roomId);
+}
+
+static Seat SeatPlayer(const std::string &name) // 调用方持有 lobbyMutex
+{
+    Seat seat;
+    if (waitingMatch) // 有人在等：坐到他对面，这一局开始
+    {
+        std::lock_guard<std::mutex> lock(waitingMatch->mutex);
+        waitingMatch->names[1] = name;
+        waitingMatch->players = 2;
+        waitingMatch->lastActivity = std::chrono::steady_clock::now();
+        seat = {waitingMatch->id, 2};
+        waitingMatch->cv.notify_all();
+        waitingMatch.reset();
+    }
+    else // 开一个新房间等人
+    {
+        auto match = std::make_shared<Match>();
+        match->id = nextRoomId++;
+        match->names[0] = name;
+        match->players = 1;
+        match->turn = 1;
+        match->moveCount = 0;
+        match->acked[0] = match->acked[1] = 0;
+        match->finished = false;
+        match->lastActivity = std::chrono::steady_clock::now();
+        match->liveStreams = 0;
+        NewGame(match->state);
+        {
+            std::unique_lock<std::shared_mutex> table(tableMutex);
+            matches[match->id] = match;
+        }
+        waitingMatch = match;
+        seat = {match->id, 1};
+    }
+    seats[name] = seat;
+    return seat;
+}
+
+Seat JoinMatch(const std::string &name)
+{
+    Seat seat;
+    {
+        std::lock_guard<std::mutex> lobby(lobbyMutex);
+        auto found = seats.find(name);
+        if (found != seats.end()) // 如果用户名已存在，回到原来的座位
+            return found->second;
+        seat = SeatPlayer(name);
+    }
+    if (seat.seat == 2)
+        NotifyListeners(seat.roomId); // 到齐了
+    return seat;
+}
+
+std::shared_ptr<Match> FindMatch(int roomId)
+{
+    std::shared_lock<std::shared_mutex> table(tableMutex);
+    auto found = matches.find(roomId);
+    return found == matches.end() ? nullptr : found->second;
+}
+
+int MatchCount()
+{
+    std::shared_lock<std::shared_mutex> table(tableMutex);
+    return (int)matches.size();
+}
+
+int WaitingPlayers()
+{
+    std::lock_guard<std::mutex> lobby(lobbyMutex);
+    return waitingMatch ? 1 : 0;
+}
+
+void FinishMatch(Match &match)
+{
+    match.finished = true;
+    match.finishedAt = std::chrono::steady_clock::now();
+
+    // 存档：这里只是编码好放进队列，写文件在存档的后台线程里
+    int64_t endTime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    ArchiveMatch(match.names, Winner(match.state) + 1, match.moveLog, match.moveCount, endTime);
+}
+
+void TouchMatch(Match &match)
+{
+    std::lock_guard<std::mutex> lock(match.mutex);
+    match.lastActivity = std::chrono::steady_clock::now();
+}
+
+MoveResult PlayMove(Match &match, int seat, const std::string &packet)
+{
+    Move move;
+    uint16_t seq;
+    if (packet.size() != MOVE_PACKET_BYTES || !DecodeMovePacket((const uint8_t *)packet.data(), move, seq))
+        return MOVE_BAD_PACKET;
+
+    {
+        std::lock_guard<std::mutex> lock(match.mutex); // 只锁这一局
+        if (seq < match.moveCount && match.moveLog.compare(seq * MOVE_PACKET_BYTES, MOVE_PACKET_BYTES, packet) == 0)
+            return MOVE_RESENT;
+        if (seat != match.turn)
+            return MOVE_NOT_YOUR_TURN;
+        if (seq != match.moveCount)
+            return MOVE_OUT_OF_SEQUENCE;
+        if (match.finished)
+            return MOVE_GAME_OVER;
+
+        // 合法就直接走，不分配内存
+        auto start = std::chrono::steady_clock::now();
+        bool legal = IsSingleMoveLegal(match.state, move);
+        if (legal)
+            ApplyMove(match.state, move);
+        validateNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        validatedMoves++;
+        if (!legal)
+        {
+            illegalMoves++;
+            return MOVE_ILLEGAL;
+        }
+        match.moveLog += packet; // 追加到着法日志
+        match.moveCount++;
+        match.turn = match.turn == 1 ? 2 : 1;
+        match.lastActivity = std::chrono::steady_clock::now();
+        if (Winner(match.state) >= 0 || match.moveCount >= MAX_MATCH_MOVES)
+            FinishMatch(match);
+    }
+    match.cv.notify_all(); // 叫醒正在 /wait 的对手
+    NotifyListeners(match.id);
+    return MOVE_ACCEPTED;
+}
+
+int SweepMatches()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lobby(lobbyMutex); // 和 JoinMatch 一样先锁大厅再锁房间表，不会死锁
+    std::unique_lock<std::shared_mutex> table(tableMutex);
+    int swept = 0;
+    for (auto it = matches.begin(); it != matches.end();)
+    {
+        Match &match = *it->second;
+        bool done;
+        {
+            std::lock_guard<std::mutex> lock(match.mutex);
+            if (match.finished)
+                done = (match.acked[0] >= match.moveCount && match.acked[1] >= match.moveCount) ||
+                       now - match.finishedAt > std::chrono::seconds(FINISHED_MATCH_SECONDS);
+            else
+                done = match.liveStreams == 0 && now - match.lastActivity > std::chrono::seconds(IDLE_MATCH_SECONDS);
+        }
+        if (!done)
+        {
+            ++it;
+            continue;
+        }
+        if (waitingMatch == it->second) // 开房间的人走了，下一个登录的人不要再坐进来
+            waitingMatch.reset();
+        for (int s = 0; s < 2; s++)
+        {
+            auto seat = seats.find(match.names[s]);
+            if (seat != seats.end() && seat->second.roomId == match.id)
+                seats.erase(seat);
+        }
+        it = matches.erase(it); // 还在处理这一局请求的线程手里有 shared_ptr，房间等它们用完才释放
+        swept++;
+    }
+    return swept;
+}
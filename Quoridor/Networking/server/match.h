@@ -0,0 +1,83 @@
+#ifndef MATCH_H
+#define MATCH_H
+
+#include "game_state.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// 服务器上的一局对战（房间）：每局自己一把锁，不同房间的请求互不等待
+// 座位号和原来的 Client-ID 一样是 1 / 2，客户端用 Room-ID + Client-ID 定位自己
+
+const int MAX_MATCH_MOVES = 1000;      // 一局最多这么多步（着法日志最多 3 KB），走满算和棋
+const int FINISHED_MATCH_SECONDS = 60; // 下完的房间最多再留这么久，等双方取走最后一步
+const int IDLE_MATCH_SECONDS = 300;    // 没下完（或者还在等对手）的房间，玩家这么久没有任何请求、也没有长连接就清掉
+
+struct Match
+{
+    int id;                            // 房间号
+    std::mutex mutex;                  // 只保护这一局的数据
+    std::condition_variable cv;        // 有新消息（同时换了回合）时唤醒这一局的 /wait
+    std::string names[2];              // 座位 1、2 的玩家名字
+    int players;                       // 已经入座的人数
+    int turn;                          // 轮到座位几（1 / 2）
+    std::string moveLog;               // 只追加的着法日志：第 k 步在 [k * MOVE_PACKET_BYTES, (k + 1) * MOVE_PACKET_BYTES)
+    int moveCount;                     // 已经走了几步（= 下一步的序号）
+    int acked[2];                      // 座位 1、2 已经确认收到的步数（/wait、/moves 的 since）
+    bool finished;                     // 分出胜负或者走满 MAX_MATCH_MOVES 步
+    std::chrono::steady_clock::time_point finishedAt; // 结束的时间
+    std::chrono::steady_clock::time_point lastActivity; // 玩家最后一次入座、走棋或者发请求的时间
+    int liveStreams;                   // 连着的玩家长连接数（长连接不轮询，连着就不算闲置）
+    GameState state;                   // 服务器这边的局面，每一步先用和客户端同一份规则检查再走（座位 1 = 玩家 0）
+};
+
+// 走一步的结果（HTTP /message 和 TCP 长连接共用 PlayMove）
+enum MoveResult
+{
+    MOVE_ACCEPTED,        // 检查通过，追加到着法日志，换手
+    MOVE_RESENT,          // 重发的包：已经收过了，照常确认
+    MOVE_NOT_YOUR_TURN,
+    MOVE_BAD_PACKET,      // 不是 MOVE_PACKET_BYTES 字节，或者着法编码不对
+    MOVE_OUT_OF_SEQUENCE, // 序号没有正好接上
+    MOVE_GAME_OVER,
+    MOVE_ILLEGAL          // 规则不允许（走法、墙壁重叠、封路）
+};
+
+struct Seat
+{
+    int roomId;
+    int seat; // 1 / 2
+};
+
+// 房间有变化（对手到齐、走了一步、结束）时调用的回调，参数是房间号；调用时不持有任何锁
+// TCP 长连接靠它推送，epoll 后端靠它唤醒挂起的 /wait（HTTP 后端的 /wait 直接等 match.cv）
+typedef void (*MatchListener)(int roomId);
+void AddMatchListener(MatchListener listener); // 启动时注册
+
+// 配对：有人在等就坐到他对面，没有就开一个新房间等人；同一个名字重复登录回到原来的座位
+Seat JoinMatch(const std::string &name);
+
+std::shared_ptr<Match> FindMatch(int roomId); // 找不到返回空指针
+int MatchCount();                             // 当前房间数
+void FinishMatch(Match &match);               // 标记这一局结束并存档（调用方持有 match.mutex）
+void TouchMatch(Match &match);                // 玩家发来了请求：刷新 lastActivity
+
+// seat 走一步：packet 是 MOVE_PACKET_BYTES 字节的二进制着法（着法编码 + 序号）
+// 用和客户端同一份规则检查，合法就追加到着法日志、换手，下完了就 FinishMatch；成功时唤醒这一局的 /wait 并通知 MatchListener
+MoveResult PlayMove(Match &match, int seat, const std::string &packet);
+
+// 着法检查的统计（/stats 输出）
+extern std::atomic<long long> validatedMoves; // 检查过的着法数
+extern std::atomic<long long> illegalMoves;   // 其中不合法、被拒绝的
+extern std::atomic<long long> validateNs;     // 检查 + 走棋一共用掉的时间
+
+// 清掉下完的房间（双方都取走了最后一步，或者结束超过 FINISHED_MATCH_SECONDS 秒）
+// 和没人管的房间（中途都走了，或者开了房间的人没等到对手就走了：闲置超过 IDLE_MATCH_SECONDS 秒），返回清掉几个
+// 名字也从配对表里删掉，之后同名登录会开新的一局
+int SweepMatches();
+int WaitingPlayers();                         // 正在等对手的人数（0 / 1）
+
+#endif
@@ -0,0 +1,333 @@
+#include "stream.h"
+#include "match.h"
+#include "../include/frame.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+const int SEND_TIMEOUT_SECONDS = 5; // 对方一直不读时推送最多卡这么久（只卡它自己的发送线程），然后断开这条连接
+const size_t READ_CHUNK = 4096;
+
+struct StreamConnection
+{
+    int fd;
+    std::mutex sendMutex;         // 回复和推送可能来自不同线程，一次只发一批；也保护下面的字段
+    std::shared_ptr<Match> match; // 订阅的房间（JOIN / WATCH 之前是空的）
+    int seat = 0;                 // 1 / 2，观战是 0
+    bool started = false;         // 推过 FRAME_START 了
+    bool ended = false;           // 推过 FRAME_END 了
+    int sent = 0;                 // 推过几步了
+    bool closed = false;          // 发送失败，等读线程收尾
+
+    std::mutex pushMutex;                // 只保护下面两个标记，持有时间很短（sendMutex 可能在阻塞的 send 里一直被占着）
+    std::condition_variable pushReady;
+    bool dirty = false;                  // 房间有变化，发送线程还没推
+    bool stopping = false;               // 连接要关了，发送线程退出
+};
+
+// 房间号 -> 订阅这个房间的连接（双方 + 观战）
+std::mutex streamsMutex;
+std::unordered_map<int, std::vector<std::shared_ptr<StreamConnection>>> subscribers;
+std::atomic<size_t> connectionCount(0);
+
+static void SendAll(StreamConnection &conn, const std::string &bytes) // 调用方持有 sendMutex
+{
+    size_t written = 0;
+    while (written < bytes.size())
+    {
+        ssize_t n = send(conn.fd, bytes.data() + written, bytes.size() - written, MSG_NOSIGNAL);
+        if (n <= 0)
+        {
+            conn.closed = true;
+            shutdown(conn.fd, SHUT_RDWR); // 读线程的 recv 会返回，由它收尾
+            return;
+        }
+        written += (size_t)n;
+    }
+}
+
+static void Reply(StreamConnection &conn, uint8_t type, const std::string &payload)
+{
+    std::string frame;
+    AppendFrame(frame, type, payload);
+    std::lock_guard<std::mutex> sending(conn.sendMutex);
+    if (!conn.closed)
+        SendAll(conn, frame);
+}
+
+// 把这一局里还没推给这条连接的（到齐、着法、结束）一次推过去，重复调用不会重复推
+static void PushUpdates(StreamConnection &conn)
+{
+    std::lock_guard<std::mutex> sending(conn.sendMutex);
+    if (conn.closed || !conn.match)
+        return;
+    std::string frames;
+    {
+        Match &match = *conn.match;
+        std::lock_guard<std::mutex> lock(match.mutex);
+        if (!conn.started && match.players == 2)
+        {
+            AppendFrame(frames, FRAME_START, match.names[0] + "\n" + match.names[1]);
+            conn.started = true;
+        }
+        for (; conn.sent < match.moveCount; conn.sent++)
+        {
+            std::string payload = match.moveLog.substr((size_t)conn.sent * MOVE_PACKET_BYTES, MOVE_PACKET_BYTES);
+            payload += (char)(conn.sent % 2 == 0 ? 2 : 1); // 第 k 步是座位 k % 2 + 1 走的，走完轮到另一个
+            AppendFrame(frames, FRAME_MOVE, payload);
+        }
+        if (match.finished && !conn.ended)
+        {
+            AppendFrame(frames, FRAME_END, std::string(1, (char)(Winner(match.state) + 1)));
+            conn.ended = true;
+        }
+        if (conn.seat == 1 || conn.seat == 2) // 和 /wait 的 since 一样，清理房间时用
+            match.acked[conn.seat - 1] = std::max(match.acked[conn.seat - 1], conn.sent);
+    }
+    if (!frames.empty())
+        SendAll(conn, frames);
+}
+
+// 每条连接自己的发送线程：被 NotifyStreams 标脏以后推送，慢的连接只卡它自己
+static void SenderThread(std::shared_ptr<StreamConnection> conn)
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(conn->pushMutex);
+            conn->pushReady.wait(lock, [&]
+                                 { return conn->dirty || conn->stopping; });
+            if (conn->stopping)
+                return;
+            conn->dirty = false;
+        }
+        PushUpdates(*conn);
+    }
+}
+
+void NotifyStreams(int roomId) // 在走棋的线程（HTTP 处理函数、epoll 工作线程、别的长连接）里调用，只标脏不发送
+{
+    std::vector<std::shared_ptr<StreamConnection>> targets;
+    {
+        std::lock_guard<std::mutex> lock(streamsMutex);
+        auto found = subscribers.find(roomId);
+        if (found == subscribers.end())
+            return;
+        targets = found->second;
+    }
+    for (auto &conn : targets)
+    {
+        std::lock_guard<std::mutex> lock(conn->pushMutex);
+        conn->dirty = true;
+        conn->pushReady.notify_one();
+    }
+}
+
+size_t StreamConnections()
+{
+    return connectionCount.load();
+}
+
+static void Subscribe(const std::shared_ptr<StreamConnection> &conn, const std::shared_ptr<Match> &match, int seat)
+{
+    {
+        std::lock_guard<std::mutex> sending(conn->sendMutex);
+        conn->match = match;
+        conn->seat = seat;
+    }
+    if (seat != 0) // 玩家的长连接连着，这一局就不算闲置
+    {
+        std::lock_guard<std::mutex> lock(match->mutex);
+        match->liveStreams++;
+        match->lastActivity = std::chrono::steady_clock::now();
+    }
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    subscribers[match->id].push_back(conn);
+}
+
+static void Unsubscribe(const std::shared_ptr<StreamConnection> &conn)
+{
+    if (conn->match && conn->seat != 0) // 从断开的时候开始算闲置
+    {
+        std::lock_guard<std::mutex> lock(conn->match->mutex);
+        conn->match->liveStreams--;
+        conn->match->lastActivity = std::chrono::steady_clock::now();
+    }
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    if (!conn->match)
+        return;
+    auto found = subscribers.find(conn->match->id);
+    if (found == subscribers.end())
+        return;
+    std::vector<std::shared_ptr<StreamConnection>> &list = found->second;
+    list.erase(std::remove(list.begin(), list.end(), conn), list.end());
+    if (list.empty())
+        subscribers.erase(found);
+}
+
+static const char *RejectText(MoveResult result) // 和 /message 的回复一样
+{
+    switch (result)
+    {
+    case MOVE_NOT_YOUR_TURN:
+        return "Not your turn to send message.";
+    case MOVE_BAD_PACKET:
+        return "Bad move packet.";
+    case MOVE_OUT_OF_SEQUENCE:
+        return "Out of sequence.";
+    case MOVE_GAME_OVER:
+        return "Game over.";
+    case MOVE_ILLEGAL:
+        return "Illegal move.";
+    default:
+        return "";
+    }
+}
+
+static void Reject(StreamConnection &conn, MoveResult result, const char *text)
+{
+    Reply(conn, FRAME_REJECT, std::string(1, (char)result) + text);
+}
+
+static void HandleFrame(const std::shared_ptr<StreamConnection> &conn, uint8_t type, const std::string &payload)
+{
+    if (type == FRAME_JOIN || type == FRAME_WATCH)
+    {
+        if (conn->match) // 一条连接只订阅一个房间
+        {
+            Reject(*conn, MOVE_BAD_PACKET, "Already joined.");
+            return;
+        }
+        std::shared_ptr<Match> match;
+        int seat = 0;
+        if (type == FRAME_JOIN)
+        {
+            Seat joined = JoinMatch(payload);
+            match = FindMatch(joined.roomId);
+            seat = joined.seat;
+        }
+        else
+        {
+            match = FindMatch((int)UnpackRoom(payload));
+        }
+        if (!match)
+        {
+            Reject(*conn, MOVE_BAD_PACKET, "No such room.");
+            return;
+        }
+        Reply(*conn, FRAME_SEAT, PackRoom((uint32_t)match->id) + (char)seat);
+        Subscribe(conn, match, seat);
+        PushUpdates(*conn); // 补发到齐和已经走过的着法（对手由 JoinMatch 通知）
+        return;
+    }
+
+    if (type == FRAME_MOVE)
+    {
+        std::shared_ptr<Match> match;
+        int seat;
+        {
+            std::lock_guard<std::mutex> sending(conn->sendMutex);
+            match = conn->match;
+            seat = conn->seat;
+        }
+        if (!match || seat == 0)
+        {
+            Reject(*conn, MOVE_NOT_YOUR_TURN, RejectText(MOVE_NOT_YOUR_TURN));
+            return;
+        }
+        MoveResult result = PlayMove(*match, seat, payload); // 走成了由 PlayMove 通知 NotifyStreams，走棋的一方收到这一步就是确认
+        if (result != MOVE_ACCEPTED && result != MOVE_RESENT)
+            Reject(*conn, result, RejectText(result));
+        return;
+    }
+
+    Reject(*conn, MOVE_BAD_PACKET, "Unknown frame.");
+}
+
+static void ConnectionThread(int fd)
+{
+    auto conn = std::make_shared<StreamConnection>();
+    conn->fd = fd;
+    connectionCount++;
+    std::thread sender(SenderThread, conn);
+
+    std::string buffer;
+    char chunk[READ_CHUNK];
+    while (true)
+    {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            break;
+        buffer.append(chunk, (size_t)n);
+
+        size_t offset = 0;
+        uint8_t type;
+        std::string payload;
+        bool bad = false;
+        while (NextFrame(buffer, offset, type, payload, bad))
+            HandleFrame(conn, type, payload);
+        if (bad)
+            break;
+        buffer.erase(0, offset);
+    }
+
+    Unsubscribe(conn);
+    shutdown(fd, SHUT_RDWR); // 发送线程如果卡在 send 里，马上返回
+    {
+        std::lock_guard<std::mutex> lock(conn->pushMutex);
+        conn->stopping = true;
+        conn->pushReady.notify_one();
+    }
+    sender.join();
+    {
+        std::lock_guard<std::mutex> sending(conn->sendMutex); // 等正在推送的线程发完再关
+        conn->closed = true;
+        close(fd);
+    }
+    connectionCount--;
+}
+
+bool StartStreamServer(int port)
+{
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0)
+        return false;
+    int yes = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)port);
+    if (bind(listener, (sockaddr *)&address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+    {
+        close(listener);
+        return false;
+    }
+    AddMatchListener(NotifyStreams);
+
+    std::thread([listener]
+                {
+                    while (true)
+                    {
+                        int fd = accept(listener, nullptr, nullptr);
+                        if (fd < 0)
+                            continue;
+                        int yes = 1;
+                        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes)); // 每一帧都是几个字节，马上发
+                        timeval timeout = {SEND_TIMEOUT_SECONDS, 0};
+                        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                        std::thread(ConnectionThread, fd).detach();
+                    } })
+        .detach();
+    return true;
+}
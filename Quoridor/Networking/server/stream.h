@@ -0,0 +1,15 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <cstddef>
+
+// TCP 长连接（帧格式见 include/frame.h）：和 HTTP 接口共用同一张房间表和 PlayMove
+// 客户端连上以后配对或者观战，之后服务器有新着法、换手、结束就直接推过去，不用轮询
+// 每条连接一个线程阻塞读、一个线程推送；房间有变化时（可能来自任何线程，HTTP 的 /message 也会触发）只把连接标脏，
+// 真正的 send 在这条连接自己的发送线程里做，对方不读也卡不住走棋的线程
+
+bool StartStreamServer(int port); // 开始监听（后台线程），端口打不开返回 false
+void NotifyStreams(int roomId);   // 这个房间有变化（到齐、走棋、结束）：叫订阅的连接把还没推过的推过去（MatchListener，不阻塞）
+size_t StreamConnections();       // 当前连着的长连接数
+
+#endif
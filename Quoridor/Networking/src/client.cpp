@@ -1,193 +1,635 @@
-#include "../thirdparty/httplib.h"
-#include "client.h"
-#include <iostream>
-#include <thread>
-#include <mutex>
-#include <chrono>
-
-using namespace std;
-
-
-httplib::Client client("192.168.1.107:25565");
-std::string last_message = "";
-mutex messageMutex;
-
-string username;
-string opponent ="" ;
-string GameMessage = "";
-int client_id = -1;
-int currentTurn = -1;
-
-
-
-bool check_connection(const httplib::Result &result); //  检查初始状态
-
-string getclientID();
-
-string getOpponentName();
-
-string waitForUsername(); //  停下线程等待获取用户名字
-
-string waitForUserAction();
-
-void fetchMessageThread(); // 获取消息线程
-
-void initClient();
-
-void startClientThread() // 接入点API
-{
-    thread(initClient).detach();
-}
-
-
-// ------------------------------函数体------------------------------------------------
-
-bool check_connection(const httplib::Result &result) //  检查初始状态
-{
-    if (!result || result->status != 200)
-    {
-        cout << "Error: Server connection failed!" << endl;
-        return false;
-    }
-    else
-    {
-        this_thread::sleep_for(chrono::seconds(1));
-        cout << "Success: Server connection successful!" << endl;
-        return true;
-    }
-}
-
-string getClientID()
-{
-    lock_guard<mutex> lock(messageMutex); // 使用 lock_guard 确保线程安全
-    if (client_id == -1)
-    {
-        return "";
-    }
-    return to_string(client_id);
-}
-
-string getOpponentName()
-{
-    lock_guard<mutex> lock(messageMutex); // 使用 lock_guard 确保线程安全
-    return opponent;
-}
-
-string waitForUsername() // 停止线程等待用户名字
-{
-    std::cout <<  "Waiting for username...\n\n";
-    while (strlen(getClientName()) == 0) // 只要用户名还是空的，就等待
-    { 
-        std::this_thread::sleep_for(std::chrono::seconds(1)); // 每秒检查一次
-    }
-    std::cout << "Username received: " << getClientName() << std::endl;
-    return getClientName();
-}
-
-string waitForUserAction()
-{
-
-    while(actionType != 1 && actionType != 2 )
-    {
-        std::this_thread::sleep_for(std::chrono::seconds(1)); // 每秒检查一次
-    }
-    std::cout << "Your action have been changed succesfully! | ActionType: " << actionType << " | {" << x << " , " << y << "}" << " | isHorizontal: " << isHorizontal << " | " << endl;
-
-    return "ActionType: " + std::to_string(actionType) + " | {" + to_string(x) + " , " + to_string(y) + "}" + " | isHorizontal: " + to_string(isHorizontal) + " | ";
-}
-
-void fetchMessageThread()
-{
-    string last_message = "";
-    while (true)
-    {
-        httplib::Result turn_result = client.Get("/turn");
-
-        if (!turn_result || turn_result->status != 200)
-        {
-            cout << "cannot connect to server..." << endl;
-            this_thread::sleep_for(chrono::milliseconds(1500));
-            continue;
-        }
-
-        int current_clientID = stoi(turn_result->body);
-        currentTurn = current_clientID - 1 ; // get 1 first
-
-        if (client_id == current_clientID)
-        {
-
-            httplib::Result messages_result = client.Get("/messages");
-
-            if (messages_result && messages_result->status == 200)
-            {
-                string new_message = messages_result->body;
-
-                // 如果消息是新的，则显示
-                if (new_message != last_message)
-                {
-                    GameMessage = new_message ;
-                    cout <<  new_message << endl;
-                    last_message = new_message; // 更新上一次显示的消息
-
-                }
-            }
-
-            // Messages to Send
-
-            string message_to_send = waitForUserAction();
-
-            httplib::Headers headers =
-            {
-                {"Client-ID", to_string(client_id)}, {"Action-Type", to_string(actionType)}, {"X", to_string(x)}, {"Y", to_string(y)}, {"Is-Horizontal", to_string(isHorizontal)}
-            };
-            httplib::Result res = client.Post("/message", headers, message_to_send , "text/plain"); 
-            actionType = 0 ;
-            x = 0 ;
-            y = 0 ;
-        }
-
-        this_thread::sleep_for(chrono::milliseconds(1500));
-    }
-}
-
-void initClient()
-{
-    username = waitForUsername();
-
-    // login
-
-    httplib::Result result = client.Post("/login", username, "text/plain");
-
-    if (check_connection(result) == false)
-    {
-        return;
-    }
-    client_id = stoi(result->body);
-    cout << "Your client ID is " << client_id << endl;
-
-    // Turn & Ready
-
-    bool waiting_printed = false;
-    while (true)
-    {
-        httplib::Headers headers = {{"Client-ID", to_string(client_id)}};
-        httplib::Result ready_result = client.Get("/ready", headers);
-        if (ready_result && ready_result->body != "Waiting")
-        {
-            opponent = ready_result->body;
-            cout << "Client connection successful, you can start talking." << endl;
-            cout << "Your oppnent: " + opponent << endl << endl << endl;
-            break;
-        }
-        if (!waiting_printed)
-        {
-            cout << "Waiting for other clients to join..." << endl;
-            waiting_printed = true;
-        }
-        this_thread::sleep_for(chrono::seconds(1));
-    }
-
-    // Messages
-
-    thread(fetchMessageThread).detach(); // 开始获取信息线程
-}
+#include "../thirdparty/httplib.h"
+#include "client.h"
+#include "move_queue.h"
+#include "frame.h"
+#include "game_state.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <vector>
+
+using namespace std;
+
+
+string server_address = "192.168.1.107:25565"; // 启动参数或者 QUORIDOR_SERVER 环境变量可以改
+unique_ptr<httplib::Client> client;            // 一条保持连接（keep-alive）的连接，只有网络线程用，initClient 里建
+const int LONG_POLL_SECONDS = 25;              // 和服务器的 /wait 一致
+const int CONNECT_TIMEOUT_SECONDS = 3;         // 连不上就早点重试，不要等默认的 300 秒
+const int WRITE_TIMEOUT_SECONDS = 5;
+const int RECONNECT_MIN_MS = 250;              // 断线重连的间隔从 250 ms 开始翻倍，最多 8 秒
+const int RECONNECT_MAX_MS = 8000;
+const int STREAM_PORT_OFFSET = 1;              // 服务器的 TCP 长连接端口 = HTTP 端口 + 1，连不上就用 HTTP
+mutex messageMutex;
+
+// TCP 长连接（帧格式见 frame.h）：读线程收推送，写线程发自己的着法
+mutex streamMutex;                              // 保护下面几个和发送
+socket_t stream_socket = INVALID_SOCKET;        // 断线重连期间是 INVALID_SOCKET
+string pending_packet = "";                     // 发出去还没收到服务器推回来的自己的着法，重连后再发一次
+chrono::steady_clock::time_point pending_click; // 它是什么时候点的
+chrono::steady_clock::time_point pending_sent;  // 它发出去的时间
+atomic<size_t> stream_received(0);              // 收到的着法数（= 下一步的序号）
+
+// 请求统计：每个接口的请求数、失败数和最近的往返时间，F3 显示（getNetworkStats）
+enum Route
+{
+    ROUTE_LOGIN,
+    ROUTE_READY,
+    ROUTE_WAIT,
+    ROUTE_MESSAGE,
+    ROUTE_STREAM, // TCP 长连接：发出着法到服务器推回来
+    ROUTE_COUNT
+};
+const char *ROUTE_NAMES[ROUTE_COUNT] = {"/login", "/ready", "/wait", "/message", "tcp move"};
+const size_t RTT_SAMPLES = 256; // 每个接口保留最近多少次往返时间算中位数
+
+struct RouteStats
+{
+    size_t requests = 0;
+    size_t failures = 0;   // 没有拿到回应（连接断了、超时）
+    vector<double> rtt_ms; // 最近 RTT_SAMPLES 次，循环覆盖
+    size_t next = 0;
+};
+
+mutex statsMutex;
+RouteStats route_stats[ROUTE_COUNT];
+size_t reconnects = 0;
+chrono::steady_clock::time_point stats_start;
+bool stats_started = false;
+
+string username;
+string opponent ="" ;
+int client_id = -1;
+string room_id = "1"; // 服务器分配的房间号，之后每个请求都带上
+int currentTurn = 0;  // 座位 1 先走
+
+MoveQueue outgoingMoves;
+MoveQueue incomingMoves;
+
+mutex usernameMutex; // 名字由渲染线程（room.cpp）确认，网络线程等它
+condition_variable usernameReady;
+string confirmedName = "";
+
+vector<double> sendLatencies; // 每一步从点击到服务器确认的毫秒数（只有网络线程读写）
+
+
+
+bool check_connection(const httplib::Result &result); //  检查初始状态
+
+string getclientID();
+
+string getOpponentName();
+
+string waitForUsername(); //  停下线程等待获取用户名字
+
+string waitForUserAction(size_t seq, QueuedMove &queued); // 等玩家走完一步，返回编码好的二进制着法（seq = 这一步的序号）
+
+void printSendLatencies(); // 打印这一局每步从点击到发出的延迟
+
+httplib::Result sendRequest(Route route, const function<httplib::Result()> &send); // 发请求，连接断了就退避重连重发
+
+void fetchMessageThread(); // 获取消息线程
+
+socket_t connectStream(); // 连服务器的 TCP 长连接端口，连不上返回 INVALID_SOCKET
+
+void streamThread(socket_t sock); // TCP 长连接：收推送，断了就退避重连
+
+void initClient();
+
+void startClientThread() // 接入点API
+{
+    thread(initClient).detach();
+}
+
+void setServerAddress(const char *address)
+{
+    if (address != nullptr && address[0] != '\0')
+    {
+        server_address = address;
+    }
+}
+
+
+// ------------------------------函数体------------------------------------------------
+
+void recordRequest(Route route, double rtt_ms, bool ok)
+{
+    lock_guard<mutex> lock(statsMutex);
+    if (!stats_started)
+    {
+        stats_start = chrono::steady_clock::now();
+        stats_started = true;
+    }
+    RouteStats &stats = route_stats[route];
+    stats.requests++;
+    if (!ok)
+    {
+        stats.failures++;
+        return;
+    }
+    if (stats.rtt_ms.size() < RTT_SAMPLES)
+    {
+        stats.rtt_ms.push_back(rtt_ms);
+    }
+    else
+    {
+        stats.rtt_ms[stats.next] = rtt_ms;
+    }
+    stats.next = (stats.next + 1) % RTT_SAMPLES;
+}
+
+httplib::Result sendRequest(Route route, const function<httplib::Result()> &send)
+{
+    // 连接断了（没有回应）就隔一会儿重连重发，直到服务器回应为止；httplib 发下一个请求时会自己重新建连接
+    // 服务器对重发的同一步着法（序号相同）会再确认一次，同一个名字重新登录会回到原来的座位，所以都可以放心重发
+    int backoff_ms = RECONNECT_MIN_MS;
+    while (true)
+    {
+        auto start = chrono::steady_clock::now();
+        httplib::Result result = send();
+        recordRequest(route, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), (bool)result);
+        if (result && result->status < 500)
+        {
+            return result;
+        }
+        int delay_ms = backoff_ms + rand() % (backoff_ms / 4 + 1); // 加一点随机，免得一起断线的客户端同时重连
+        if (result)
+        {
+            cout << "Server error " << result->status << " on " << ROUTE_NAMES[route] << ", retrying in " << delay_ms << " ms..." << endl;
+        }
+        else
+        {
+            cout << "cannot connect to server (" << httplib::to_string(result.error()) << "), retrying in " << delay_ms << " ms..." << endl;
+        }
+        this_thread::sleep_for(chrono::milliseconds(delay_ms));
+        backoff_ms = min(backoff_ms * 2, RECONNECT_MAX_MS);
+        {
+            lock_guard<mutex> lock(statsMutex);
+            reconnects++;
+        }
+    }
+}
+
+string getNetworkStats()
+{
+    lock_guard<mutex> lock(statsMutex);
+    size_t total = 0;
+    for (const RouteStats &stats : route_stats)
+    {
+        total += stats.requests;
+    }
+    double seconds = stats_started ? chrono::duration<double>(chrono::steady_clock::now() - stats_start).count() : 0;
+    char line[128];
+    snprintf(line, sizeof(line), "%s  %zu req  %.2f req/s  reconnects %zu\n", server_address.c_str(), total, seconds > 0 ? total / seconds : 0.0, reconnects);
+    string text = line;
+    for (int route = 0; route < ROUTE_COUNT; route++)
+    {
+        const RouteStats &stats = route_stats[route];
+        if (stats.requests == 0)
+        {
+            continue;
+        }
+        vector<double> sorted = stats.rtt_ms;
+        sort(sorted.begin(), sorted.end());
+        double median = sorted.empty() ? 0 : sorted[sorted.size() / 2];
+        snprintf(line, sizeof(line), "%-9s %5zu req  %3zu failed  median RTT %.2f ms\n", ROUTE_NAMES[route], stats.requests, stats.failures, median);
+        text += line;
+    }
+    return text;
+}
+
+bool check_connection(const httplib::Result &result) //  检查初始状态
+{
+    if (!result || result->status != 200)
+    {
+        cout << "Error: Server connection failed!" << endl;
+        return false;
+    }
+    else
+    {
+        cout << "Success: Server connection successful!" << endl;
+        return true;
+    }
+}
+
+string getClientID()
+{
+    lock_guard<mutex> lock(messageMutex); // 使用 lock_guard 确保线程安全
+    if (client_id == -1)
+    {
+        return "";
+    }
+    return to_string(client_id);
+}
+
+string getOpponentName()
+{
+    lock_guard<mutex> lock(messageMutex); // 使用 lock_guard 确保线程安全
+    return opponent;
+}
+
+void SubmitUsername(const char *name)
+{
+    {
+        lock_guard<mutex> lock(usernameMutex);
+        confirmedName = name;
+    }
+    usernameReady.notify_one();
+}
+
+string waitForUsername() // 停止线程等待用户名字
+{
+    std::cout <<  "Waiting for username...\n\n";
+    unique_lock<mutex> lock(usernameMutex);
+    usernameReady.wait(lock, []
+                       { return !confirmedName.empty(); }); // 名字一确认就被唤醒
+    std::cout << "Username received: " << confirmedName << std::endl;
+    return confirmedName;
+}
+
+string waitForUserAction(size_t seq, QueuedMove &queued)
+{
+    WaitMove(outgoingMoves, queued, -1); // Game() 一放进来就被唤醒
+    char text[4];
+    FormatMove(queued.move, text);
+    std::cout << "Your action have been changed succesfully! | " << text << endl;
+
+    uint8_t packet[MOVE_PACKET_BYTES];
+    EncodeMovePacket(queued.move, (uint16_t)seq, packet);
+    return string((const char *)packet, MOVE_PACKET_BYTES);
+}
+
+void printSendLatencies()
+{
+    if (sendLatencies.empty())
+    {
+        return;
+    }
+    vector<double> sorted = sendLatencies;
+    sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for (double ms : sorted)
+    {
+        total += ms;
+    }
+    printf("Input-to-send latency over %zu moves: mean %.2f ms, median %.2f ms, max %.2f ms\n",
+           sorted.size(), total / sorted.size(), sorted[sorted.size() / 2], sorted.back());
+}
+
+string describeMessage(const string &message) // 二进制着法转成可读的 m14 / h35 / v62，在终端显示用
+{
+    Move move;
+    uint16_t seq;
+    if (message.size() != MOVE_PACKET_BYTES || !DecodeMovePacket((const uint8_t *)message.data(), move, seq))
+    {
+        return message;
+    }
+    char text[4];
+    FormatMove(move, text);
+    return "#" + to_string(seq) + " " + text;
+}
+
+void fetchMessageThread()
+{
+    size_t seen = 0; // 已经看过的消息数（包括自己发出去的）
+    while (true)
+    {
+        // 长轮询：服务器在对手走完或者轮到自己时才返回，对手的着法一到就能看到
+        httplib::Headers wait_headers = {{"Client-ID", to_string(client_id)}, {"Room-ID", room_id}};
+        httplib::Result wait_result = sendRequest(ROUTE_WAIT, [&]
+                                                  { return client->Get("/wait?since=" + to_string(seen), wait_headers); });
+
+        if (wait_result->status == 404)
+        {
+            cout << "Room closed." << endl;
+            return;
+        }
+        if (wait_result->status != 200)
+        {
+            cout << "Unexpected /wait status " << wait_result->status << endl;
+            return;
+        }
+
+        seen = stoul(wait_result->get_header_value("Message-Count"));
+        int current_clientID = stoi(wait_result->get_header_value("Turn"));
+
+        // body 是上次之后的所有着法（卡住多久都一次补上），自己走的已经画过了，只把对手的交给 Game()
+        const string &moves = wait_result->body;
+        for (size_t offset = 0; offset + MOVE_PACKET_BYTES <= moves.size(); offset += MOVE_PACKET_BYTES)
+        {
+            string new_message = moves.substr(offset, MOVE_PACKET_BYTES);
+            cout << describeMessage(new_message) << endl;
+            Move move;
+            uint16_t seq;
+            if (!DecodeMovePacket((const uint8_t *)new_message.data(), move, seq))
+            {
+                continue;
+            }
+            int mover = seq % 2 == 0 ? 1 : 2; // 序号为偶数的是座位 1 走的
+            if (mover != client_id)
+            {
+                PushMove(incomingMoves, move, mover);
+            }
+        }
+
+        if (wait_result->has_header("Winner")) // 这一局下完了
+        {
+            cout << "Game over, winner: client " << wait_result->get_header_value("Winner") << endl;
+            printSendLatencies();
+            cout << getNetworkStats();
+            return;
+        }
+
+        if (client_id == current_clientID)
+        {
+            // Messages to Send
+
+            QueuedMove queued;
+            string message_to_send = waitForUserAction(seen, queued);
+            double queued_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - queued.committed).count();
+
+            httplib::Headers headers =
+            {
+                {"Client-ID", to_string(client_id)}, {"Room-ID", room_id}
+            };
+            httplib::Result res = sendRequest(ROUTE_MESSAGE, [&]
+                                              { return client->Post("/message", headers, message_to_send, "application/octet-stream"); });
+            if (res->status == 200)
+            {
+                seen++; // 自己这条也算看过，下一次 /wait 等的是对手的回应
+                double acked_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - queued.committed).count();
+                sendLatencies.push_back(acked_ms);
+                printf("Move sent %.3f ms after the click, acknowledged after %.2f ms\n", queued_ms, acked_ms);
+            }
+        }
+    }
+}
+
+socket_t connectStream()
+{
+    size_t colon = server_address.rfind(':');
+    string host = colon == string::npos ? server_address : server_address.substr(0, colon);
+    int port = colon == string::npos ? 80 : atoi(server_address.c_str() + colon + 1);
+    httplib::Error error;
+    return httplib::detail::create_client_socket(host, "", port + STREAM_PORT_OFFSET, AF_UNSPEC, true, false, nullptr,
+                                                 CONNECT_TIMEOUT_SECONDS, 0, 0, 0, WRITE_TIMEOUT_SECONDS, 0, "", error); // 读不设超时：推送随时会来
+}
+
+bool sendFrame(socket_t sock, uint8_t type, const string &payload) // 调用方持有 streamMutex
+{
+    string frame;
+    AppendFrame(frame, type, payload);
+    size_t written = 0;
+    while (written < frame.size())
+    {
+        ssize_t n = httplib::detail::send_socket(sock, frame.data() + written, frame.size() - written, 0);
+        if (n <= 0)
+        {
+            return false;
+        }
+        written += (size_t)n;
+    }
+    return true;
+}
+
+bool readFrame(socket_t sock, string &buffer, uint8_t &type, string &payload)
+{
+    while (true)
+    {
+        size_t offset = 0;
+        bool bad = false;
+        if (NextFrame(buffer, offset, type, payload, bad))
+        {
+            buffer.erase(0, offset);
+            return true;
+        }
+        if (bad)
+        {
+            return false;
+        }
+        char chunk[1024];
+        ssize_t n = httplib::detail::read_socket(sock, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+        {
+            return false;
+        }
+        buffer.append(chunk, (size_t)n);
+    }
+}
+
+void streamWriterThread() // 玩家一走完（Game() 放进 outgoingMoves）就发出去
+{
+    QueuedMove queued;
+    while (WaitMove(outgoingMoves, queued, -1))
+    {
+        uint8_t packet[MOVE_PACKET_BYTES];
+        EncodeMovePacket(queued.move, (uint16_t)stream_received.load(), packet); // 轮到自己时对手的着法都收到了
+        lock_guard<mutex> lock(streamMutex);
+        pending_packet.assign((const char *)packet, MOVE_PACKET_BYTES);
+        pending_click = queued.committed;
+        pending_sent = chrono::steady_clock::now();
+        double queued_ms = chrono::duration<double, milli>(pending_sent - queued.committed).count();
+        if (stream_socket != INVALID_SOCKET && sendFrame(stream_socket, FRAME_MOVE, pending_packet))
+        {
+            printf("Move sent %.3f ms after the click\n", queued_ms);
+        }
+        // 没发出去（正在重连）：连上以后 runStream 会再发
+    }
+}
+
+// 一次连接：配对（同一个名字回到原来的座位），然后收推送，直到这一局结束（返回 true）或者连接断了（返回 false）
+bool runStream(socket_t sock)
+{
+    {
+        lock_guard<mutex> lock(streamMutex);
+        if (!sendFrame(sock, FRAME_JOIN, username))
+        {
+            return false;
+        }
+        stream_socket = sock;
+        if (!pending_packet.empty()) // 断线前发的那一步：服务器收过就不理，没收过就照常走
+        {
+            sendFrame(sock, FRAME_MOVE, pending_packet);
+        }
+    }
+
+    string buffer, payload;
+    uint8_t type;
+    while (readFrame(sock, buffer, type, payload))
+    {
+        if (type == FRAME_SEAT && payload.size() == 5)
+        {
+            {
+                lock_guard<mutex> lock(messageMutex); // 渲染线程通过 getClientID() 读
+                client_id = (uint8_t)payload[4];
+            }
+            room_id = to_string(UnpackRoom(payload));
+            cout << "Your client ID is " << client_id << " (room " << room_id << ", TCP stream)" << endl;
+        }
+        else if (type == FRAME_START)
+        {
+            size_t newline = payload.find('\n');
+            string names[2] = {payload.substr(0, newline), newline == string::npos ? "" : payload.substr(newline + 1)};
+            {
+                lock_guard<mutex> lock(messageMutex);
+                opponent = names[client_id == 1 ? 1 : 0];
+            }
+            cout << "Client connection successful, you can start talking." << endl;
+            cout << "Your oppnent: " + opponent << endl << endl << endl;
+        }
+        else if (type == FRAME_MOVE && payload.size() == MOVE_PACKET_BYTES + 1)
+        {
+            string packet = payload.substr(0, MOVE_PACKET_BYTES);
+            Move move;
+            uint16_t seq;
+            if (!DecodeMovePacket((const uint8_t *)packet.data(), move, seq) || seq < stream_received.load())
+            {
+                continue; // 重连以后服务器从头补发，已经收过的跳过
+            }
+            stream_received.store((size_t)seq + 1);
+            cout << describeMessage(packet) << endl;
+            int mover = seq % 2 == 0 ? 1 : 2; // 序号为偶数的是座位 1 走的
+            if (mover != client_id)
+            {
+                PushMove(incomingMoves, move, mover);
+                continue;
+            }
+            lock_guard<mutex> lock(streamMutex); // 自己的着法推回来了：服务器已经收下
+            if (packet == pending_packet)
+            {
+                auto now = chrono::steady_clock::now();
+                recordRequest(ROUTE_STREAM, chrono::duration<double, milli>(now - pending_sent).count(), true);
+                sendLatencies.push_back(chrono::duration<double, milli>(now - pending_click).count());
+                pending_packet.clear();
+            }
+        }
+        else if (type == FRAME_END && payload.size() == 1)
+        {
+            cout << "Game over, winner: client " << (int)(uint8_t)payload[0] << endl;
+            printSendLatencies();
+            cout << getNetworkStats();
+            return true;
+        }
+        else if (type == FRAME_REJECT && !payload.empty())
+        {
+            cout << "Server rejected: " << payload.substr(1) << endl;
+            if (payload.substr(1) == "No such room.")
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void streamThread(socket_t sock)
+{
+    thread(streamWriterThread).detach();
+    int backoff_ms = RECONNECT_MIN_MS;
+    while (true)
+    {
+        if (sock != INVALID_SOCKET)
+        {
+            backoff_ms = RECONNECT_MIN_MS;
+            bool over = runStream(sock);
+            {
+                lock_guard<mutex> lock(streamMutex);
+                stream_socket = INVALID_SOCKET;
+            }
+            httplib::detail::close_socket(sock);
+            if (over)
+            {
+                CloseMoveQueue(outgoingMoves); // 写线程退出
+                return;
+            }
+        }
+        int delay_ms = backoff_ms + rand() % (backoff_ms / 4 + 1);
+        cout << "Stream disconnected, reconnecting in " << delay_ms << " ms..." << endl;
+        this_thread::sleep_for(chrono::milliseconds(delay_ms));
+        backoff_ms = min(backoff_ms * 2, RECONNECT_MAX_MS);
+        {
+            lock_guard<mutex> lock(statsMutex);
+            reconnects++;
+        }
+        sock = connectStream();
+    }
+}
+
+void initClient()
+{
+    username = waitForUsername();
+
+    // 一条连接用到底：保持连接省掉每个请求的 TCP 握手，关掉 Nagle 免得小请求多等 40 ms 的延迟确认
+    cout << "Server: " << server_address << endl;
+    client.reset(new httplib::Client(server_address));
+    client->set_keep_alive(true);
+    client->set_tcp_nodelay(true);
+    client->set_connection_timeout(CONNECT_TIMEOUT_SECONDS, 0);
+    client->set_read_timeout(LONG_POLL_SECONDS + 5, 0); // /wait 最多挂起 LONG_POLL_SECONDS 秒，读超时要比它长
+    client->set_write_timeout(WRITE_TIMEOUT_SECONDS, 0);
+
+    // 先试 TCP 长连接：着法、到齐、结束都由服务器推过来；连不上（旧服务器、端口被挡）再用下面的 HTTP 长轮询
+    socket_t sock = connectStream();
+    if (sock != INVALID_SOCKET)
+    {
+        streamThread(sock);
+        return;
+    }
+    cout << "Stream port unavailable, using HTTP." << endl;
+
+    // login
+
+    httplib::Result result = sendRequest(ROUTE_LOGIN, [&]
+                                         { return client->Post("/login", username, "text/plain"); });
+
+    if (check_connection(result) == false)
+    {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(messageMutex); // 渲染线程通过 getClientID() 读
+        client_id = stoi(result->body);
+    }
+    if (result->has_header("Room-ID"))
+    {
+        room_id = result->get_header_value("Room-ID");
+    }
+    cout << "Your client ID is " << client_id << " (room " << room_id << ")" << endl;
+
+    // Turn & Ready
+
+    bool waiting_printed = false;
+    while (true)
+    {
+        httplib::Headers headers = {{"Client-ID", to_string(client_id)}, {"Room-ID", room_id}};
+        httplib::Result ready_result = sendRequest(ROUTE_READY, [&]
+                                                   { return client->Get("/ready", headers); });
+        if (ready_result->status == 200 && ready_result->body != "Waiting")
+        {
+            {
+                lock_guard<mutex> lock(messageMutex);
+                opponent = ready_result->body;
+            }
+            cout << "Client connection successful, you can start talking." << endl;
+            cout << "Your oppnent: " + opponent << endl << endl << endl;
+            break;
+        }
+        if (!waiting_printed)
+        {
+            cout << "Waiting for other clients to join..." << endl;
+            waiting_printed = true;
+        }
+        this_thread::sleep_for(chrono::seconds(1));
+    }
+
+    // Messages
+
+    thread(fetchMessageThread).detach(); // 开始获取信息线程
+}
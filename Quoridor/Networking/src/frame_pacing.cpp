@@ -0,0 +1,56 @@
+#include "frame_pacing.h"
+#include "scheduler.h"
+#include "raylib.h"
+#include <cstdio>
+
+const int ACTIVE_FPS = 60;
+const int IDLE_FPS = 10;       // 空闲时的帧率：输入和网络最多晚 100 ms 被看到，看到以后马上回到全速
+const double IDLE_AFTER = 0.5; // 最后一次变化之后再保持全速这么久（秒），鼠标停一下又动不会来回切
+
+bool adaptivePacing = true;
+bool frameDirty = false;
+double lastActive = 0;
+int targetFps = ACTIVE_FPS;
+
+void MarkFrameDirty()
+{
+    frameDirty = true;
+}
+
+// EndDrawing 里刚轮询过输入，这里看到的是下一帧要处理的输入
+bool InputArrived()
+{
+    Vector2 delta = GetMouseDelta();
+    if (delta.x != 0 || delta.y != 0 || GetMouseWheelMove() != 0)
+        return true;
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_MIDDLE; button++)
+    {
+        if (IsMouseButtonDown(button) || IsMouseButtonReleased(button))
+            return true;
+    }
+    return GetKeyPressed() != 0 || IsWindowResized(); // GetKeyPressed 会取走按键队列，客户端里别处没用它（输入框用的是 GetCharPressed）
+}
+
+void PaceFrames()
+{
+    double now = GetTime();
+    if (InputArrived() || frameDirty || HasScheduledTasks())
+    {
+        lastActive = now;
+    }
+    frameDirty = false;
+
+    int fps = !adaptivePacing || now - lastActive < IDLE_AFTER ? ACTIVE_FPS : IDLE_FPS;
+    if (fps != targetFps)
+    {
+        SetTargetFPS(fps);
+        targetFps = fps;
+    }
+}
+
+std::string GetPacingStats()
+{
+    char text[96];
+    snprintf(text, sizeof(text), "fps %d  target %d  %s", GetFPS(), targetFps, adaptivePacing ? "adaptive pacing (F5)" : "fixed 60 fps (F5)");
+    return text;
+}
@@ -0,0 +1,50 @@
+#include "frame_stats.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <cstdio>
+
+const int FRAME_STATS_WINDOW = 60; // 按最近这么多帧取平均
+
+int drawCalls = 0;
+bool cacheStaticLayers = true;
+double frameStart = 0;
+double frameMsTotal = 0;           // 这一轮累计的毫秒数和绘制调用数
+long long drawCallsTotal = 0;
+int framesCounted = 0;
+double frameMsMax = 0;             // 这一轮最慢的一帧（卡顿在平均值里看不出来）
+double averageMs = 0;              // 上一轮的平均值（叠加层显示这个，数字不会每帧跳）
+double maxMs = 0;
+double averageDrawCalls = 0;
+
+void BeginFrameStats()
+{
+    drawCalls = 0;
+    frameStart = GetTime();
+}
+
+void EndFrameStats()
+{
+    rlDrawRenderBatchActive(); // 攒着的顶点在 EndDrawing 里才提交，先提交掉，这部分 CPU 时间也算进来
+    double frameMs = (GetTime() - frameStart) * 1000.0;
+    frameMsTotal += frameMs;
+    if (frameMs > frameMsMax)
+        frameMsMax = frameMs;
+    drawCallsTotal += drawCalls;
+    if (++framesCounted == FRAME_STATS_WINDOW)
+    {
+        averageMs = frameMsTotal / framesCounted;
+        maxMs = frameMsMax;
+        averageDrawCalls = (double)drawCallsTotal / framesCounted;
+        frameMsTotal = 0;
+        frameMsMax = 0;
+        drawCallsTotal = 0;
+        framesCounted = 0;
+    }
+}
+
+std::string GetFrameStats()
+{
+    char text[96];
+    snprintf(text, sizeof(text), "frame %.3f ms (max %.3f)  draw calls %.0f", averageMs, maxMs, averageDrawCalls);
+    return text;
+}
@@ -0,0 +1,52 @@
+#include "move_queue.h"
+
+void PushMove(MoveQueue &queue, const Move &move, int seat)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.moves.push_back({move, seat, std::chrono::steady_clock::now()});
+    }
+    queue.ready.notify_one();
+}
+
+bool PollMove(MoveQueue &queue, QueuedMove &out)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.moves.empty())
+        return false;
+    out = queue.moves.front();
+    queue.moves.pop_front();
+    return true;
+}
+
+bool WaitMove(MoveQueue &queue, QueuedMove &out, int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    auto ready = [&]
+    { return !queue.moves.empty() || queue.closed; };
+    if (timeoutMs < 0)
+        queue.ready.wait(lock, ready);
+    else
+        queue.ready.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+    if (queue.moves.empty())
+        return false;
+    out = queue.moves.front();
+    queue.moves.pop_front();
+    return true;
+}
+
+void CloseMoveQueue(MoveQueue &queue)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.closed = true;
+    }
+    queue.ready.notify_all();
+}
+
+void ClearMoveQueue(MoveQueue &queue)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.moves.clear();
+    queue.closed = false;
+}
@@ -0,0 +1,42 @@
+#include "scheduler.h"
+#include "raylib.h"
+#include <vector>
+
+struct ScheduledTask
+{
+    double due;                 // 到期时间（GetTime() 的秒数）
+    std::function<void()> task;
+};
+
+std::vector<ScheduledTask> scheduledTasks; // 只有渲染线程用，数量很少，直接线性找
+
+void ScheduleTask(double delaySeconds, std::function<void()> task)
+{
+    scheduledTasks.push_back({GetTime() + delaySeconds, std::move(task)});
+}
+
+void RunScheduledTasks()
+{
+    double now = GetTime();
+    while (true)
+    {
+        // 找最早到期的（同时到期按放进来的顺序）
+        int next = -1;
+        for (int i = 0; i < (int)scheduledTasks.size(); i++)
+        {
+            if (scheduledTasks[i].due <= now && (next == -1 || scheduledTasks[i].due < scheduledTasks[next].due))
+                next = i;
+        }
+        if (next == -1)
+            return;
+
+        std::function<void()> task = std::move(scheduledTasks[next].task);
+        scheduledTasks.erase(scheduledTasks.begin() + next); // 先拿出来再执行，任务里可以再放新任务
+        task();
+    }
+}
+
+bool HasScheduledTasks()
+{
+    return !scheduledTasks.empty();
+}
@@ -1,108 +1,143 @@
-#include "raylib.h"
-#include "menu.h"
-#include "game.h"
-// Define possible game states
-enum GameState
-{
-    MENU_STATE,
-    ROOM_STATE,
-    GAME_STATE,
-    VICTORY_STATE
-};
-
-
-int main()
-{
-    int screenWidth = 480;
-    int screenHeight = 1000;
-
-    InitWindow(screenWidth, screenHeight, "Quoridor");
-    InitMenu();
-    SetTargetFPS(60);
-
-    // Initialize game state
-    GameState currentState = MENU_STATE;
-    int winner = 0; // 0: 无胜利者, 1: 玩家1胜利, 2: 玩家2胜利
-
-    while (!WindowShouldClose())
-    {
-        if (currentState == GAME_STATE)
-        {
-            winner = Game();
-            if (winner == 1 || winner == 2)
-            {
-                currentState = VICTORY_STATE; // 切换到胜利界面
-            }
-        }
-
-        BeginDrawing();
-        ClearBackground(RAYWHITE);
-
-        // State machine
-        switch (currentState)
-        {
-        case MENU_STATE:
-        {
-            DrawMenu();
-            int clickResult = ClickButton();
-            if (clickResult == 1)
-            {
-                // Transition to room state
-                currentState = ROOM_STATE;
-            }
-            else if (clickResult == 2)
-            {
-                // Exit game
-                CloseWindow() ;
-                break;
-            }
-            break;
-        }
-
-        case ROOM_STATE:
-        {
-            DrawRoom();
-            int start_the_game = GameStart();
-            if (start_the_game == 1)
-            {
-                // Transition to game state
-                currentState = GAME_STATE;
-            }
-            break;
-        }
-
-        case GAME_STATE:
-        {
-            // Clear previous screen before drawing game
-            ClearBackground(RAYWHITE);
-
-            DrawGame();
-            break;
-        }
-
-        case VICTORY_STATE:
-        {
-            DrawVictory(winner);
-            int clickResult = ClickButton();
-            if (clickResult == 1)
-            {
-                ResetGame();
-                currentState = GAME_STATE;
-            }
-            else if (clickResult == 2)
-            {
-                // Exit game
-                CloseWindow();
-                break;
-            }
-            break;
-        }
-        }
-
-        EndDrawing();
-    }
-
-    UnloadMenu();
-    CloseWindow();
-    return 0;
-}
+#include "raylib.h"
+#include "menu.h"
+#include "game.h"
+#include "client.h"
+#include "frame_stats.h"
+#include "frame_pacing.h"
+#include "scheduler.h"
+#include <cstdlib>
+// Define possible game states
+enum GameState
+{
+    MENU_STATE,
+    ROOM_STATE,
+    GAME_STATE,
+    VICTORY_STATE
+};
+
+
+int main(int argc, char **argv)
+{
+    int screenWidth = 480;
+    int screenHeight = 1000;
+    bool showNetworkStats = false; // F3 切换：显示请求统计、帧率和每帧的绘制调用数、耗时
+
+    setServerAddress(argc > 1 ? argv[1] : getenv("QUORIDOR_SERVER")); // client.exe [主机:端口]，不给就用环境变量或默认地址
+
+    InitWindow(screenWidth, screenHeight, "Quoridor");
+    InitMenu();
+    SetTargetFPS(60);
+
+    // Initialize game state
+    GameState currentState = MENU_STATE;
+    int winner = 0; // 0: 无胜利者, 1: 玩家1胜利, 2: 玩家2胜利
+
+    while (!WindowShouldClose())
+    {
+        RunScheduledTasks(); // 到时间的延时任务（比如点了按钮 100 ms 后切界面）
+
+        if (currentState == GAME_STATE)
+        {
+            winner = Game();
+            if (winner == 1 || winner == 2)
+            {
+                currentState = VICTORY_STATE; // 切换到胜利界面
+            }
+        }
+
+        BeginDrawing();
+        BeginFrameStats();
+        ClearBackground(RAYWHITE);
+
+        // State machine
+        switch (currentState)
+        {
+        case MENU_STATE:
+        {
+            DrawMenu();
+            int clickResult = ClickButton();
+            if (clickResult == 1)
+            {
+                // Transition to room state
+                currentState = ROOM_STATE;
+            }
+            else if (clickResult == 2)
+            {
+                // Exit game
+                CloseWindow() ;
+                break;
+            }
+            break;
+        }
+
+        case ROOM_STATE:
+        {
+            DrawRoom();
+            int start_the_game = GameStart();
+            if (start_the_game == 1)
+            {
+                // Transition to game state
+                currentState = GAME_STATE;
+            }
+            break;
+        }
+
+        case GAME_STATE:
+        {
+            // Clear previous screen before drawing game
+            ClearBackground(RAYWHITE);
+
+            DrawGame();
+            break;
+        }
+
+        case VICTORY_STATE:
+        {
+            DrawVictory(winner);
+            int clickResult = ClickButton();
+            if (clickResult == 1)
+            {
+                ResetGame();
+                currentState = GAME_STATE;
+            }
+            else if (clickResult == 2)
+            {
+                // Exit game
+                CloseWindow();
+                break;
+            }
+            break;
+        }
+        }
+
+        EndFrameStats(); // 叠加层自己不算
+
+        if (IsKeyPressed(KEY_F3))
+        {
+            showNetworkStats = !showNetworkStats;
+        }
+        if (IsKeyPressed(KEY_F4))
+        {
+            cacheStaticLayers = !cacheStaticLayers;
+        }
+        if (IsKeyPressed(KEY_F5))
+        {
+            adaptivePacing = !adaptivePacing;
+        }
+        if (showNetworkStats)
+        {
+            std::string frame = GetFrameStats() + (cacheStaticLayers ? "  static layers cached (F4)" : "  static layers redrawn (F4)");
+            DrawText(frame.c_str(), 10, 10, 10, DARKGRAY);
+            DrawText(GetPacingStats().c_str(), 10, 24, 10, DARKGRAY);
+            DrawText(getNetworkStats().c_str(), 10, 38, 10, DARKGRAY);
+        }
+
+        EndDrawing();
+        PaceFrames(); // 没有输入、没有新着法、没有动画时降到低帧率
+    }
+
+    UnloadGame();
+    UnloadMenu();
+    CloseWindow();
+    return 0;
+}
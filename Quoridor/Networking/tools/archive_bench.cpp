@@ -0,0 +1,170 @@
+// 对局存档基准：往一个新的存档文件里写 N 局随机对局，然后重新打开，测查询速度
+// 输出：
+//   写入  ArchiveMatch 的耗时分位数（走棋请求里真正多出来的时间）、写线程每秒写进文件的局数、每局占多少字节
+//   打开  重新打开存档（沿记录头走一遍建索引）用了多久
+//   查询  按玩家、按日期、按玩家 + 日期查最新 20 局的平均耗时，以及不用索引从头扫一遍文件的耗时
+//
+// 编译（在 Quoridor/Networking 目录下）：
+//   g++ -O2 -std=c++17 -I../Core/include tools/archive_bench.cpp server/archive.cpp ../Core/src/*.cpp -o archive_bench -lpthread
+// 运行（文件会先被删掉重建）：
+//   ./archive_bench [局数] [玩家数] [存档文件]
+//   例如 ./archive_bench 1000000 10000 /tmp/bench.archive
+
+#include "../server/archive.h"
+#include "game_state.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const int64_t START_TIME = 1735689600; // 2025-01-01 00:00:00 UTC
+const int SECONDS_PER_GAME = 30;       // 每局的结束时间往后推 30 秒
+const int QUERY_COUNT = 10000;         // 每种查询跑几次
+const int SCAN_COUNT = 5;              // 从头扫描跑几次
+const int QUERY_LIMIT = 20;
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+static uint32_t NextRandom() // xorshift64*
+{
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (uint32_t)((rngState * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static double Seconds(Clock::time_point start)
+{
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+static string PlayerName(int k)
+{
+    return "player" + to_string(k);
+}
+
+// 不用索引：映射整个文件，沿记录头找某个玩家的对局
+static size_t ScanForPlayer(const string &path, const string &player)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    fstat(fd, &st);
+    const uint8_t *data = (const uint8_t *)mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    size_t found = 0;
+    for (uint64_t offset = 0; offset + sizeof(ArchiveHeader) <= (uint64_t)st.st_size;)
+    {
+        ArchiveHeader header;
+        memcpy(&header, data + offset, sizeof(header));
+        const char *names = (const char *)data + offset + sizeof(header);
+        if ((header.nameLength[0] == player.size() && memcmp(names, player.data(), player.size()) == 0) ||
+            (header.nameLength[1] == player.size() && memcmp(names + header.nameLength[0], player.data(), player.size()) == 0))
+            found++;
+        offset += header.length;
+    }
+    munmap((void *)data, (size_t)st.st_size);
+    close(fd);
+    return found;
+}
+
+int main(int argc, char **argv)
+{
+    int gameCount = argc > 1 ? atoi(argv[1]) : 1000000;
+    int playerCount = argc > 2 ? atoi(argv[2]) : 10000;
+    string path = argc > 3 ? argv[3] : "/tmp/quoridor_bench.archive";
+
+    unlink(path.c_str());
+    if (!OpenArchive(path))
+    {
+        printf("cannot open %s\n", path.c_str());
+        return 1;
+    }
+
+    // ------------------------------写入------------------------------
+    vector<double> appendNs;
+    appendNs.reserve(gameCount);
+    string moveLog;
+    long long totalMoves = 0;
+    auto start = Clock::now();
+    for (int k = 0; k < gameCount; k++)
+    {
+        string names[2] = {PlayerName(NextRandom() % playerCount), PlayerName(NextRandom() % playerCount)};
+        int moveCount = 20 + NextRandom() % 101;
+        moveLog.assign((size_t)moveCount * MOVE_PACKET_BYTES, '\0');
+        for (int m = 0; m < moveCount; m++)
+            moveLog[m * MOVE_PACKET_BYTES] = (char)(1 + NextRandom() % 209);
+        totalMoves += moveCount;
+
+        auto before = Clock::now();
+        ArchiveMatch(names, 1 + NextRandom() % 2, moveLog, moveCount, START_TIME + (int64_t)k * SECONDS_PER_GAME);
+        appendNs.push_back(chrono::duration<double, nano>(Clock::now() - before).count());
+    }
+    FlushArchive();
+    double writeSeconds = Seconds(start);
+    CloseArchive();
+
+    sort(appendNs.begin(), appendNs.end());
+    struct stat st;
+    stat(path.c_str(), &st);
+    printf("%d games, %d players, %.1f moves per game\n", gameCount, playerCount, (double)totalMoves / gameCount);
+    printf("append  ArchiveMatch p50 %.0f ns  p99 %.0f ns  max %.0f ns\n", appendNs[appendNs.size() / 2], appendNs[appendNs.size() * 99 / 100], appendNs.back());
+    printf("        %.0f games/s written, file %.1f MB (%.1f bytes per game)\n", gameCount / writeSeconds, st.st_size / 1048576.0, (double)st.st_size / gameCount);
+
+    // ------------------------------打开------------------------------
+    start = Clock::now();
+    OpenArchive(path);
+    printf("open    %zu games indexed in %.0f ms\n", ArchivedGames(), Seconds(start) * 1000);
+
+    // ------------------------------查询------------------------------
+    vector<ArchivedGame> games;
+    int64_t lastTime = START_TIME + (int64_t)(gameCount - 1) * SECONDS_PER_GAME;
+    const char *names[3] = {"player", "day", "player + month"};
+    for (int kind = 0; kind < 3; kind++)
+    {
+        long long returned = 0, wrong = 0;
+        start = Clock::now();
+        for (int q = 0; q < QUERY_COUNT; q++)
+        {
+            ArchiveQuery query = {"", 0, 0, QUERY_LIMIT};
+            if (kind != 1)
+                query.player = PlayerName(NextRandom() % playerCount);
+            if (kind > 0)
+            {
+                int64_t span = kind == 1 ? 86400 : 30 * 86400;
+                query.from = START_TIME + (int64_t)(NextRandom() % (uint32_t)max<int64_t>(1, lastTime - START_TIME));
+                query.to = query.from + span;
+            }
+            returned += QueryArchive(query, games);
+            for (const ArchivedGame &game : games)
+            {
+                bool playerOk = query.player.empty() || game.names[0] == query.player || game.names[1] == query.player;
+                bool timeOk = game.endTime >= query.from && (query.to <= 0 || game.endTime < query.to);
+                wrong += !playerOk || !timeOk;
+            }
+        }
+        double seconds = Seconds(start);
+        printf("query   %-15s %8.1f us  (%.1f games per query, %lld wrong)\n", names[kind], seconds * 1e6 / QUERY_COUNT, (double)returned / QUERY_COUNT, wrong);
+    }
+
+    // 不用索引：从头扫描整个文件
+    size_t scanned = 0, indexed = 0;
+    start = Clock::now();
+    for (int q = 0; q < SCAN_COUNT; q++)
+    {
+        string player = PlayerName(NextRandom() % playerCount);
+        scanned += ScanForPlayer(path, player);
+        indexed += QueryArchive({player, 0, 0, gameCount}, games);
+    }
+    printf("scan    %-15s %8.1f ms  (%zu games found by scan, %zu by index)\n", "player", Seconds(start) * 1000 / SCAN_COUNT, scanned, indexed);
+
+    CloseArchive();
+    return scanned == indexed ? 0 : 1;
+}
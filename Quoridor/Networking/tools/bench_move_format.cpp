@@ -0,0 +1,138 @@
+// 着法编码基准：对比原来的“5 个请求头 + 文本 body”和现在的 3 字节二进制着法
+// 每种格式都测：一步棋占多少字节（请求头行 + body），编码和解码每秒多少步
+//   旧格式编码 = 客户端拼 Action-Type / X / Y / Is-Horizontal 请求头和 waitForUserAction 的文本
+//   旧格式解码 = 服务器 stoi 四个请求头 + 拼 "Client N sent message: " + Game() 逐个字符挑数字
+//   新格式编码 / 解码 = EncodeMovePacket / DecodeMovePacket
+// 两种格式都还要带 Client-ID、Room-ID 和 HTTP 自己的请求行、Content-Type 等，这部分不变，不算在内
+//
+// 编译（在 Quoridor/Networking 目录下）：
+//   g++ -O2 -std=c++17 -I../Core/include tools/bench_move_format.cpp ../Core/src/*.cpp -o bench_move_format
+// 运行：
+//   ./bench_move_format [着法数（百万）]
+
+#include "game_state.h"
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct TextMove // 旧格式：请求头的值 + body
+{
+    string actionType, x, y, isHorizontal;
+    string body;
+};
+
+static TextMove EncodeText(const Move &move)
+{
+    TextMove text;
+    text.actionType = to_string(move.type);
+    text.x = to_string(move.x);
+    text.y = to_string(move.y);
+    text.isHorizontal = to_string(move.horizontal);
+    text.body = "ActionType: " + to_string(move.type) + " | {" + to_string(move.x) + " , " + to_string(move.y) + "}" + " | isHorizontal: " + to_string(move.horizontal) + " | ";
+    return text;
+}
+
+// 服务器读请求头、存消息，客户端再从消息里挑数字（和原来的 Game() 一样）
+static Move DecodeText(const TextMove &text, vector<int> &gameData)
+{
+    int actionType = stoi(text.actionType);
+    int x = stoi(text.x);
+    int y = stoi(text.y);
+    bool horizontal = stoi(text.isHorizontal);
+    (void)actionType, (void)x, (void)y, (void)horizontal; // 原来的服务器读了但没用
+
+    string message = "Client 1 sent message: " + text.body;
+    gameData.clear();
+    for (size_t i = 0; i < message.length(); i++)
+    {
+        if (isdigit((unsigned char)message[i]))
+            gameData.push_back(message[i] - '0');
+    }
+    return Move{(uint8_t)gameData[1], (int8_t)gameData[2], (int8_t)gameData[3], gameData[4] != 0};
+}
+
+static size_t TextBytes(const TextMove &text) // "Name: value\r\n" 四行 + body
+{
+    return strlen("Action-Type: \r\n") + text.actionType.size() + strlen("X: \r\n") + text.x.size() + strlen("Y: \r\n") + text.y.size() +
+           strlen("Is-Horizontal: \r\n") + text.isHorizontal.size() + text.body.size();
+}
+
+static bool SameMove(const Move &a, const Move &b)
+{
+    return a.type == b.type && a.x == b.x && a.y == b.y && (a.type != MOVE_WALL || a.horizontal == b.horizontal);
+}
+
+int main(int argc, char **argv)
+{
+    long long total = (long long)((argc > 1 ? atof(argv[1]) : 2.0) * 1000000);
+
+    // 所有可能的着法：81 个移动 + 128 个墙槽
+    vector<Move> moves;
+    for (int code = 1; code < 256; code++)
+    {
+        Move move;
+        if (DecodeMoveCode((uint8_t)code, move))
+            moves.push_back(move);
+    }
+
+    size_t textBytes = 0;
+    for (const Move &move : moves)
+        textBytes += TextBytes(EncodeText(move));
+    printf("%zu distinct moves\n", moves.size());
+    printf("bytes per move    text %.1f  (headers + body)    binary %d\n\n", (double)textBytes / moves.size(), MOVE_PACKET_BYTES);
+
+    // 旧格式
+    vector<int> gameData;
+    long long checksum = 0, wrong = 0;
+    auto start = Clock::now();
+    vector<TextMove> encoded(moves.size());
+    for (long long k = 0; k < total; k++)
+    {
+        size_t m = (size_t)(k % moves.size());
+        encoded[m] = EncodeText(moves[m]);
+        checksum += encoded[m].body.size();
+    }
+    double textEncode = chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (long long k = 0; k < total; k++)
+    {
+        size_t m = (size_t)(k % moves.size());
+        Move move = DecodeText(encoded[m], gameData);
+        wrong += !SameMove(move, moves[m]);
+    }
+    double textDecode = chrono::duration<double>(Clock::now() - start).count();
+
+    // 二进制
+    vector<uint8_t> packets(moves.size() * MOVE_PACKET_BYTES);
+    start = Clock::now();
+    for (long long k = 0; k < total; k++)
+    {
+        size_t m = (size_t)(k % moves.size());
+        EncodeMovePacket(moves[m], (uint16_t)k, &packets[m * MOVE_PACKET_BYTES]);
+        checksum += packets[m * MOVE_PACKET_BYTES];
+    }
+    double binaryEncode = chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (long long k = 0; k < total; k++)
+    {
+        size_t m = (size_t)(k % moves.size());
+        Move move;
+        uint16_t seq;
+        wrong += !DecodeMovePacket(&packets[m * MOVE_PACKET_BYTES], move, seq) || !SameMove(move, moves[m]);
+        checksum += seq;
+    }
+    double binaryDecode = chrono::duration<double>(Clock::now() - start).count();
+
+    printf("%-8s %16s %16s\n", "format", "encode moves/s", "decode moves/s");
+    printf("%-8s %16.0f %16.0f\n", "text", total / textEncode, total / textDecode);
+    printf("%-8s %16.0f %16.0f\n", "binary", total / binaryEncode, total / binaryDecode);
+    printf("\nround-trip errors %lld  (checksum %lld)\n", wrong, checksum);
+    return wrong == 0 ? 0 : 1;
+}
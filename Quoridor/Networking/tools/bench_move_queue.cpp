@@ -0,0 +1,112 @@
+// 客户端交接基准：渲染线程“点击”走一步，网络线程多久以后拿到这一步（拿到就可以发 /message 了）
+// 对比两种写法：
+//   轮询  原来的 waitForUserAction：网络线程每隔 N 毫秒看一次全局变量 actionType
+//   队列  现在的 MoveQueue：Game() PushMove，网络线程在 WaitMove 里被条件变量唤醒
+// 两次点击之间随机隔 20 ~ 200 ms（像真人一样不会正好对上轮询的节拍）
+// 输出从点击到网络线程拿到着法的延迟：平均、中位数、p99、最大
+//
+// 编译（在 Quoridor/Networking 目录下）：
+//   g++ -O2 -std=c++17 -Iinclude -I../Core/include tools/bench_move_queue.cpp src/move_queue.cpp ../Core/src/*.cpp -o bench_move_queue -lpthread
+// 运行（原来轮询间隔是 1000 ms，20 步就要跑 20 多秒）：
+//   ./bench_move_queue [步数] [轮询间隔毫秒]
+
+#include "move_queue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+static uint32_t NextRandom() // xorshift64*
+{
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (uint32_t)((rngState * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static double Ms(Clock::time_point from, Clock::time_point to)
+{
+    return chrono::duration<double, milli>(to - from).count();
+}
+
+static void PrintLatencies(const char *name, vector<double> &latencies)
+{
+    sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (double ms : latencies)
+        total += ms;
+    auto at = [&](double q)
+    { return latencies[min(latencies.size() - 1, (size_t)(q * latencies.size()))]; };
+    printf("%-8s %6zu moves  mean %9.3f ms  median %9.3f ms  p99 %9.3f ms  max %9.3f ms\n",
+           name, latencies.size(), total / latencies.size(), at(0.5), at(0.99), latencies.back());
+}
+
+// 原来的写法：点击时写全局变量，网络线程 sleep 一段时间再看
+static vector<double> PollHandoff(int moves, int pollMs)
+{
+    atomic<int> actionType(0);
+    Clock::time_point clicked;
+    vector<double> latencies;
+    thread network([&]
+                   {
+                       for (int k = 0; k < moves; k++)
+                       {
+                           while (actionType.load() == 0)
+                               this_thread::sleep_for(chrono::milliseconds(pollMs));
+                           latencies.push_back(Ms(clicked, Clock::now()));
+                           actionType.store(0);
+                       } });
+    for (int k = 0; k < moves; k++)
+    {
+        while (actionType.load() != 0) // 上一步还没被拿走（轮询慢的时候）
+            this_thread::sleep_for(chrono::milliseconds(1));
+        this_thread::sleep_for(chrono::milliseconds(20 + NextRandom() % 181));
+        clicked = Clock::now();
+        actionType.store(1);
+    }
+    network.join();
+    return latencies;
+}
+
+// 现在的写法：PushMove / WaitMove
+static vector<double> QueueHandoff(int moves)
+{
+    MoveQueue queue;
+    vector<double> latencies;
+    thread network([&]
+                   {
+                       QueuedMove queued;
+                       while (WaitMove(queue, queued, -1))
+                           latencies.push_back(Ms(queued.committed, Clock::now())); });
+    for (int k = 0; k < moves; k++)
+    {
+        this_thread::sleep_for(chrono::milliseconds(20 + NextRandom() % 181));
+        PushMove(queue, {(uint8_t)MOVE_PAWN, 1, 4, false}, 1);
+    }
+    this_thread::sleep_for(chrono::milliseconds(50));
+    CloseMoveQueue(queue);
+    network.join();
+    return latencies;
+}
+
+int main(int argc, char **argv)
+{
+    int moves = argc > 1 ? atoi(argv[1]) : 20;
+    int pollMs = argc > 2 ? atoi(argv[2]) : 1000;
+
+    printf("click-to-handoff latency, %d moves, clicks 20-200 ms apart\n", moves);
+    vector<double> queued = QueueHandoff(moves);
+    PrintLatencies("queue", queued);
+    vector<double> polled = PollHandoff(moves, pollMs);
+    char name[32];
+    snprintf(name, sizeof(name), "poll%d", pollMs);
+    PrintLatencies(name, polled);
+    return queued.size() == (size_t)moves ? 0 : 1;
+}
@@ -0,0 +1,587 @@
+// 模拟玩家的压力测试：几千个无界面的玩家，按客户端（src/client.cpp）的 HTTP 协议下完整的对局
+// 每个玩家：POST /login 配对 -> 每秒问一次 /ready 直到对手到齐 -> 循环 /wait?since=N，轮到自己就"想"一会儿，
+// 然后从 GenerateMoves 里随机挑一步合法的着法 POST /message；一局下完重新登录，下一局
+// "想"的时间平均 1 / 每人每秒步数 秒（在 0.5 ~ 1.5 倍之间随机），所以总的走棋速度可以按人数和步数控制
+// 所有玩家在一个线程里用 epoll 跑（一个玩家一条保持连接的连接），只连本机的服务器
+//
+// 检查服务器的回合判断：
+//   - 每走几步，刚走完的一方紧接着抢先再走一步，服务器必须回 "Not your turn"
+//   - 自己这边按步数算出来轮到谁，和 /wait 回复里的 Turn 比对；轮到自己时发的着法不应该被当成抢先
+// 输出每个接口的请求数、出错率和延迟分位数、一步着法从发出到对手收到的延迟、每秒请求数和步数、回合判断出错的次数
+//
+// 编译（在 Quoridor/Networking 目录下）：
+//   g++ -O2 -std=c++17 -I../Core/include tools/client_load.cpp ../Core/src/*.cpp -o client_load
+// 运行：
+//   ./client_load [玩家数] [每人每秒步数] [秒数] [服务器地址] [服务器进程号]
+//   例如 ./server --epoll > /dev/null & ./client_load 2000 0.5 30 127.0.0.1:25565 $!
+
+#include "game_state.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <queue>
+#include <random>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const int LONG_POLL_SECONDS = 25;  // 和服务器的 /wait 一致
+const int REPLY_TIMEOUT_MS = 5000; // /wait 以外的请求最多等这么久；/wait 多等 LONG_POLL_SECONDS
+const int READY_POLL_MS = 1000;    // 和客户端一样，每秒问一次 /ready
+const int RECONNECT_MIN_MS = 250;  // 和客户端一样，断线重连从 250 ms 开始翻倍，最多 8 秒
+const int RECONNECT_MAX_MS = 8000;
+const int PROBE_EVERY = 5;         // 自己每走几步，紧接着抢先再走一步
+
+enum Route
+{
+    ROUTE_LOGIN,
+    ROUTE_READY,
+    ROUTE_WAIT,
+    ROUTE_MESSAGE,
+    ROUTE_PROBE, // 抢先走的 /message
+    ROUTE_COUNT,
+    ROUTE_NONE = ROUTE_COUNT
+};
+const char *ROUTE_NAMES[ROUTE_COUNT] = {"/login", "/ready", "/wait", "/message", "probe"};
+
+enum Phase
+{
+    PHASE_LOGIN, // 还没有座位
+    PHASE_READY, // 等对手到齐
+    PHASE_PLAY
+};
+
+struct Player
+{
+    int fd = -1;
+    string buffer;               // 收到还没处理的字节
+    Phase phase = PHASE_LOGIN;
+    Route route = ROUTE_NONE;    // 正在等回复的请求（一次只有一个，和客户端一样）
+    Clock::time_point sentAt;
+    Clock::time_point deadline;
+    uint64_t timer = 0;          // 最新的定时器编号，旧的定时器到了就忽略
+    int failures = 0;            // 连续出错次数，决定重连间隔
+    int games = 0;
+    string roomId;
+    int seat = 0;
+    GameState state;
+    size_t seen = 0;             // 已经知道的步数（包括自己走的）
+    Move pending;                // 发出去还没确认的着法（回复 200 以后再走到本地局面上）
+    int moves = 0;               // 自己走了几步（每 PROBE_EVERY 步抢先走一次）
+};
+
+struct Timer
+{
+    Clock::time_point at;
+    int player;
+    uint64_t id;
+    bool operator<(const Timer &other) const { return at > other.at; } // priority_queue 取最早的
+};
+
+struct Reply
+{
+    int status = 0;
+    string head; // 状态行和响应头
+    string body;
+};
+
+struct LastMove // 房间里最近发出的一步，对手的 /wait 收到它时算送达延迟
+{
+    size_t seq;
+    Clock::time_point sentAt;
+};
+
+struct Load
+{
+    sockaddr_in server;
+    string tag;
+    double thinkMs;
+    int epfd;
+    vector<Player> players;
+    priority_queue<Timer> timers;
+    uint64_t nextTimer = 1;
+    unordered_map<string, LastMove> lastMoves; // 房间号 -> 最近一步
+    mt19937 rng{12345};
+
+    vector<double> latencies[ROUTE_COUNT];
+    long long requests[ROUTE_COUNT] = {};
+    long long errors[ROUTE_COUNT] = {}; // 超时、断线、回复的状态码不对
+    vector<double> deliveries;          // 发出着法 -> 对手的 /wait 收到
+    long long reconnects = 0;
+    long long movesAccepted = 0;
+    long long movesRejected = 0;        // 合法的着法被拒绝（不合法、乱序）
+    long long gamesFinished = 0;
+    long long gamesStuck = 0;           // 轮到的一方没有合法着法，放弃的局数
+    long long probesAccepted = 0;       // 抢先走的着法被接受了：服务器的回合判断有问题
+    long long turnRefused = 0;          // 按步数该自己走，服务器却说不是
+    long long turnMismatches = 0;       // /wait 回复的 Turn 和步数对不上
+};
+
+static double Ms(Clock::time_point start)
+{
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// 服务器的常驻内存（KB），读不到返回 -1
+static long ServerRssKb(int pid)
+{
+    if (pid <= 0)
+        return -1;
+    ifstream status("/proc/" + to_string(pid) + "/status");
+    string key;
+    while (status >> key)
+    {
+        if (key == "VmRSS:")
+        {
+            long kb;
+            status >> kb;
+            return kb;
+        }
+    }
+    return -1;
+}
+
+static string Header(const Reply &reply, const string &name)
+{
+    size_t found = reply.head.find("\r\n" + name + ": ");
+    if (found == string::npos)
+        return "";
+    size_t start = found + name.size() + 4;
+    return reply.head.substr(start, reply.head.find("\r\n", start) - start);
+}
+
+// buffer 里有完整的回复就取出来
+static bool TakeReply(string &buffer, Reply &reply)
+{
+    size_t headEnd = buffer.find("\r\n\r\n");
+    if (headEnd == string::npos)
+        return false;
+    reply.head = buffer.substr(0, headEnd);
+    size_t length = 0;
+    size_t found = reply.head.find("Content-Length: ");
+    if (found != string::npos)
+        length = (size_t)atoll(reply.head.c_str() + found + 16);
+    if (buffer.size() < headEnd + 4 + length)
+        return false;
+    reply.status = atoi(reply.head.c_str() + 9); // "HTTP/1.1 200 OK"
+    reply.body = buffer.substr(headEnd + 4, length);
+    buffer.erase(0, headEnd + 4 + length);
+    return true;
+}
+
+static void Schedule(Load &load, int index, double ms)
+{
+    Player &player = load.players[index];
+    player.timer = load.nextTimer++;
+    load.timers.push({Clock::now() + chrono::microseconds((long long)(ms * 1000)), index, player.timer});
+}
+
+static void Disconnect(Load &load, Player &player)
+{
+    if (player.fd >= 0)
+    {
+        epoll_ctl(load.epfd, EPOLL_CTL_DEL, player.fd, nullptr);
+        close(player.fd);
+    }
+    player.fd = -1;
+    player.buffer.clear();
+    player.route = ROUTE_NONE;
+}
+
+// 请求出错：断开，按客户端的退避间隔重连，再从当前阶段接着来
+static void Fail(Load &load, int index)
+{
+    Player &player = load.players[index];
+    if (player.route != ROUTE_NONE)
+        load.errors[player.route]++;
+    Disconnect(load, player);
+    int delay = RECONNECT_MIN_MS << min(player.failures, 5);
+    player.failures++;
+    Schedule(load, index, min(delay, RECONNECT_MAX_MS) * (0.75 + 0.5 * (load.rng() % 1000) / 1000.0));
+}
+
+static bool Send(Load &load, int index, Route route, const string &method, const string &target, const string &body)
+{
+    Player &player = load.players[index];
+    load.requests[route]++;
+    if (player.fd < 0)
+    {
+        player.fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (player.fd < 0 || connect(player.fd, (const sockaddr *)&load.server, sizeof(load.server)) != 0)
+        {
+            player.route = route;
+            Fail(load, index);
+            return false;
+        }
+        int yes = 1;
+        setsockopt(player.fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        fcntl(player.fd, F_SETFL, fcntl(player.fd, F_GETFL) | O_NONBLOCK);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u32 = (uint32_t)index;
+        epoll_ctl(load.epfd, EPOLL_CTL_ADD, player.fd, &event);
+        if (player.failures > 0)
+            load.reconnects++;
+    }
+
+    string headers = player.seat > 0 ? "Client-ID: " + to_string(player.seat) + "\r\nRoom-ID: " + player.roomId + "\r\n" : "";
+    string request = method + " " + target + " HTTP/1.1\r\nHost: load\r\n" + headers +
+                     "Content-Length: " + to_string(body.size()) + "\r\n\r\n" + body;
+    player.route = route;
+    player.sentAt = Clock::now();
+    player.deadline = player.sentAt + chrono::milliseconds(REPLY_TIMEOUT_MS + (route == ROUTE_WAIT ? LONG_POLL_SECONDS * 1000 : 0));
+    // 请求只有几百字节，本机的发送缓冲区一定放得下；放不下就当出错
+    if (send(player.fd, request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size())
+    {
+        Fail(load, index);
+        return false;
+    }
+    return true;
+}
+
+static string MoveBody(const Move &move, size_t seq)
+{
+    uint8_t packet[MOVE_PACKET_BYTES];
+    EncodeMovePacket(move, (uint16_t)seq, packet);
+    return string((const char *)packet, MOVE_PACKET_BYTES);
+}
+
+// 随机挑一步合法的着法；没有可走的（被墙和对手堵死，墙也用完了）返回 false
+static bool RandomMove(Load &load, GameState &state, Move &move)
+{
+    Move moves[MAX_MOVES];
+    int count = GenerateMoves(state, moves);
+    if (count == 0)
+        return false;
+    move = moves[load.rng() % count];
+    return true;
+}
+
+static void Login(Load &load, int index)
+{
+    Player &player = load.players[index];
+    player.phase = PHASE_LOGIN;
+    player.seat = 0;
+    player.roomId.clear();
+    NewGame(player.state);
+    player.seen = 0;
+    Send(load, index, ROUTE_LOGIN, "POST", "/login", "load" + load.tag + "_" + to_string(index) + "_" + to_string(player.games));
+}
+
+static void Wait(Load &load, int index)
+{
+    Player &player = load.players[index];
+    Send(load, index, ROUTE_WAIT, "GET", "/wait?since=" + to_string(player.seen), "");
+}
+
+// 定时器到了：重连以后接着做、再问一次 /ready、或者想好了走棋
+static void OnTimer(Load &load, int index)
+{
+    Player &player = load.players[index];
+    if (player.phase == PHASE_LOGIN)
+    {
+        Login(load, index);
+        return;
+    }
+    if (player.phase == PHASE_READY)
+    {
+        Send(load, index, ROUTE_READY, "GET", "/ready", "");
+        return;
+    }
+    if ((int)(player.seen % 2) + 1 != player.seat || Winner(player.state) >= 0)
+    {
+        Wait(load, index); // 重连以后
+        return;
+    }
+    if (!RandomMove(load, player.state, player.pending)) // 走不动了：这一局放弃，重新配对
+    {
+        load.gamesStuck++;
+        player.games++;
+        Login(load, index);
+        return;
+    }
+    if (Send(load, index, ROUTE_MESSAGE, "POST", "/message", MoveBody(player.pending, player.seen)))
+        load.lastMoves[player.roomId] = {player.seen, player.sentAt};
+}
+
+// /wait 的回复：补上对手走的几步，检查回合，然后想着走棋、抢先走一步或者接着等
+static void OnMoves(Load &load, int index, const Reply &reply)
+{
+    Player &player = load.players[index];
+    const string &log = reply.body;
+    for (size_t offset = 0; offset + MOVE_PACKET_BYTES <= log.size(); offset += MOVE_PACKET_BYTES)
+    {
+        Move move;
+        uint16_t seq;
+        if (!DecodeMovePacket((const uint8_t *)log.data() + offset, move, seq) || seq != player.seen)
+        {
+            load.errors[ROUTE_WAIT]++;
+            continue;
+        }
+        auto last = load.lastMoves.find(player.roomId);
+        if (last != load.lastMoves.end() && last->second.seq == seq)
+            load.deliveries.push_back(Ms(last->second.sentAt));
+        ApplyMove(player.state, move);
+        player.seen++;
+    }
+
+    int winner = Winner(player.state);
+    if (!Header(reply, "Winner").empty() || winner >= 0)
+    {
+        if (player.seat == 1)
+            load.gamesFinished++; // 每局只数一次
+        load.lastMoves.erase(player.roomId);
+        player.games++;
+        Login(load, index);
+        return;
+    }
+
+    int expected = (int)(player.seen % 2) + 1; // 座位 1 先走
+    if (atoi(Header(reply, "Turn").c_str()) != expected)
+        load.turnMismatches++;
+    if (expected == player.seat)
+        Schedule(load, index, load.thinkMs * (0.5 + (load.rng() % 1000) / 1000.0));
+    else
+        Wait(load, index);
+}
+
+static void OnReply(Load &load, int index, const Reply &reply)
+{
+    Player &player = load.players[index];
+    Route route = player.route;
+    load.latencies[route].push_back(Ms(player.sentAt));
+    player.route = ROUTE_NONE;
+    player.failures = 0;
+    bool notYourTurn = reply.body.compare(0, 13, "Not your turn") == 0;
+
+    switch (route)
+    {
+    case ROUTE_LOGIN:
+        if (reply.status != 200 || Header(reply, "Room-ID").empty())
+        {
+            load.errors[route]++;
+            Schedule(load, index, READY_POLL_MS);
+            return;
+        }
+        player.roomId = Header(reply, "Room-ID");
+        player.seat = atoi(reply.body.c_str());
+        player.phase = PHASE_READY;
+        Send(load, index, ROUTE_READY, "GET", "/ready", "");
+        return;
+    case ROUTE_READY:
+        if (reply.status != 200)
+            load.errors[route]++;
+        if (reply.status == 200 && reply.body != "Waiting")
+        {
+            player.phase = PHASE_PLAY;
+            Wait(load, index);
+            return;
+        }
+        Schedule(load, index, READY_POLL_MS);
+        return;
+    case ROUTE_WAIT:
+        if (reply.status != 200)
+        {
+            load.errors[route]++;
+            Login(load, index); // 房间没了（比如服务器清掉了），重新配对
+            return;
+        }
+        OnMoves(load, index, reply);
+        return;
+    case ROUTE_MESSAGE:
+        if (reply.status == 200 && !notYourTurn)
+        {
+            ApplyMove(player.state, player.pending);
+            player.seen++;
+            load.movesAccepted++;
+            if (++player.moves % PROBE_EVERY == 0 && Winner(player.state) < 0) // 刚走完，轮到对手：再抢先走一步，服务器必须拒绝
+            {
+                GameState copy = player.state;
+                copy.turn = 1 - copy.turn;
+                Move probe = {(uint8_t)MOVE_PAWN, (int8_t)copy.x[copy.turn], (int8_t)copy.y[copy.turn], false}; // 走不动时原地不动，反正先查回合
+                RandomMove(load, copy, probe);
+                Send(load, index, ROUTE_PROBE, "POST", "/message", MoveBody(probe, player.seen));
+                return;
+            }
+        }
+        else if (notYourTurn)
+            load.turnRefused++;
+        else
+            load.movesRejected++;
+        Wait(load, index);
+        return;
+    case ROUTE_PROBE:
+        if (reply.status == 200 && !notYourTurn)
+        {
+            load.probesAccepted++; // 对手的着法还没到，这一步却走成了：两个座位的局面已经不一致
+            Login(load, index);
+            return;
+        }
+        if (reply.status != 200 && reply.status != 409) // 对手刚好走了，序号就对不上了：409 也算拒绝
+            load.errors[route]++;
+        Wait(load, index);
+        return;
+    default:
+        return;
+    }
+}
+
+static void OnReadable(Load &load, int index)
+{
+    Player &player = load.players[index];
+    char chunk[16 * 1024];
+    while (true)
+    {
+        ssize_t n = recv(player.fd, chunk, sizeof(chunk), 0);
+        if (n > 0)
+        {
+            player.buffer.append(chunk, (size_t)n);
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        Fail(load, index); // 服务器关了连接
+        return;
+    }
+    Reply reply;
+    if (player.route != ROUTE_NONE && TakeReply(player.buffer, reply))
+        OnReply(load, index, reply);
+}
+
+static void PrintLatency(const char *name, vector<double> &values, long long requests, long long errors)
+{
+    sort(values.begin(), values.end());
+    auto at = [&](double q)
+    { return values.empty() ? 0.0 : values[min(values.size() - 1, (size_t)(q * values.size()))]; };
+    printf("%-10s %9lld req  %7lld errors (%5.2f%%)  p50 %8.2f  p90 %8.2f  p99 %8.2f  max %8.2f ms\n", name, requests, errors,
+           requests > 0 ? 100.0 * errors / requests : 0.0, at(0.5), at(0.9), at(0.99), values.empty() ? 0.0 : values.back());
+}
+
+static string ServerStats(const sockaddr_in &server)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (const sockaddr *)&server, sizeof(server)) != 0)
+    {
+        if (fd >= 0)
+            close(fd);
+        return "";
+    }
+    string request = "GET /stats HTTP/1.1\r\nHost: load\r\nConnection: close\r\n\r\n";
+    send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    string buffer;
+    Reply reply;
+    char chunk[4096];
+    pollfd ready = {fd, POLLIN, 0};
+    while (!TakeReply(buffer, reply) && poll(&ready, 1, REPLY_TIMEOUT_MS) > 0)
+    {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            break;
+        buffer.append(chunk, (size_t)n);
+    }
+    close(fd);
+    return reply.body;
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 2000;
+    double rate = argc > 2 ? atof(argv[2]) : 0.5;
+    double seconds = argc > 3 ? atof(argv[3]) : 30;
+    string address = argc > 4 ? argv[4] : "127.0.0.1:25565";
+    int serverPid = argc > 5 ? atoi(argv[5]) : 0;
+
+    Load load;
+    load.server.sin_family = AF_INET;
+    size_t colon = address.find(':');
+    load.server.sin_port = htons((uint16_t)(colon == string::npos ? 25565 : atoi(address.c_str() + colon + 1)));
+    inet_pton(AF_INET, address.substr(0, colon).c_str(), &load.server.sin_addr);
+    load.tag = to_string(Clock::now().time_since_epoch().count()); // 名字每次不同
+    load.thinkMs = rate > 0 ? 1000.0 / rate : 0;
+    load.epfd = epoll_create1(0);
+
+    rlimit limit; // 每个玩家一个 fd
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    long rssBefore = ServerRssKb(serverPid);
+    load.players.resize(count);
+    auto start = Clock::now();
+    for (int k = 0; k < count; k++)
+        Login(load, k);
+
+    epoll_event events[256];
+    Clock::time_point end = start + chrono::milliseconds((long long)(seconds * 1000));
+    Clock::time_point nextSweep = Clock::now();
+    while (Clock::now() < end)
+    {
+        int waitMs = 100;
+        if (!load.timers.empty())
+            waitMs = max(0, min(waitMs, (int)chrono::duration_cast<chrono::milliseconds>(load.timers.top().at - Clock::now()).count()));
+        int n = epoll_wait(load.epfd, events, 256, waitMs);
+        for (int i = 0; i < n; i++)
+            OnReadable(load, (int)events[i].data.u32);
+
+        Clock::time_point now = Clock::now();
+        while (!load.timers.empty() && load.timers.top().at <= now)
+        {
+            Timer timer = load.timers.top();
+            load.timers.pop();
+            if (load.players[timer.player].timer == timer.id && load.players[timer.player].route == ROUTE_NONE)
+                OnTimer(load, timer.player);
+        }
+
+        if (now >= nextSweep) // 超时没有回复的请求：当作出错，断开重连
+        {
+            nextSweep = now + chrono::milliseconds(500);
+            for (int k = 0; k < count; k++)
+            {
+                if (load.players[k].route != ROUTE_NONE && load.players[k].deadline <= now)
+                    Fail(load, k);
+            }
+        }
+    }
+    double elapsed = Ms(start) / 1000;
+    long rssAfter = ServerRssKb(serverPid);
+
+    long long totalRequests = 0, totalErrors = 0;
+    for (int r = 0; r < ROUTE_COUNT; r++)
+    {
+        totalRequests += load.requests[r];
+        totalErrors += load.errors[r];
+    }
+    printf("%d players, %.2f moves per player per second while on turn, %.1f s\n", count, rate, elapsed);
+    for (int r = 0; r < ROUTE_COUNT; r++)
+        PrintLatency(ROUTE_NAMES[r], load.latencies[r], load.requests[r], load.errors[r]);
+    printf("(/wait includes the time spent waiting for the opponent)\n");
+    PrintLatency("delivery", load.deliveries, (long long)load.deliveries.size(), 0);
+    printf("throughput %.0f req/s  %.1f moves/s  %lld moves  %lld games finished  %lld abandoned  reconnects %lld  error rate %.3f%%\n",
+           totalRequests / elapsed, load.movesAccepted / elapsed, load.movesAccepted, load.gamesFinished, load.gamesStuck, load.reconnects,
+           totalRequests > 0 ? 100.0 * totalErrors / totalRequests : 0.0);
+    printf("legal moves rejected %lld\n", load.movesRejected);
+    printf("turn violations: out-of-turn moves accepted %lld / %lld  on-turn moves refused %lld  Turn header mismatches %lld\n",
+           load.probesAccepted, load.requests[ROUTE_PROBE], load.turnRefused, load.turnMismatches);
+    string stats = ServerStats(load.server);
+    if (!stats.empty())
+        printf("server /stats:\n%s", stats.c_str());
+    if (rssBefore >= 0)
+        printf("server RSS before %ld KB  after %ld KB\n", rssBefore, rssAfter);
+    return load.movesRejected + load.probesAccepted + load.turnRefused + load.turnMismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,279 @@
+// 多房间压力测试：先让 2 × M 个玩家登录（服务器两两配成 M 局），再用若干线程同时在所有房间里走棋
+// 每个房间按一局事先用随机策略下好的对局走（前几十步大多是放墙，服务器要做完整的墙壁和封路检查）
+// 每个房间的两个座位由同一个工作线程轮流扮演，走棋前先 /wait 一次（对手的消息已经到了，马上返回）
+// 每隔几步先发一步不合法的着法（原地不动），服务器应该拒绝
+// 输出登录速度、请求速度、请求延迟分位数、被拒绝的合法着法数（应该是 0）、被接受的不合法着法数（应该是 0），
+// 以及服务器 /stats 里每步着法检查的平均耗时
+// 给出服务器进程号时，从 /proc/<pid>/status 读服务器的内存占用（测之前、登录后、走完后各一次）
+//
+// 编译（在 Quoridor/Networking 目录下）：
+//   g++ -O2 -std=c++17 -I../Core/include tools/match_load.cpp ../Core/src/*.cpp -o match_load -lpthread
+// 运行：
+//   ./match_load [房间数] [每局步数] [线程数] [服务器地址] [服务器进程号]
+//   例如 ./server & ./match_load 2000 20 8 127.0.0.1:25565 $!
+
+#include "../thirdparty/httplib.h"
+#include "game_state.h"
+#include "policy.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const int SCRIPT_COUNT = 16;  // 事先下好的对局数，房间 m 走第 m % SCRIPT_COUNT 局
+const int ILLEGAL_EVERY = 7;  // 每隔几步插一步不合法的着法
+
+struct LoadMatch
+{
+    string roomId;
+    const GameRecord *script; // 这个房间要走的对局
+    GameState state;          // 客户端这边的局面，用来构造不合法的着法
+    size_t seen;
+};
+
+struct LoadShared
+{
+    string address;
+    int matches;
+    int moves;
+    int threads;
+    vector<LoadMatch> rooms;
+    atomic<int> nextJoin;
+    atomic<int> errors;     // 连接失败、非 200
+    atomic<int> rejected;   // 合法的着法被拒绝（不是 200）
+    atomic<int> accepted;   // 不合法的着法被接受
+    atomic<int> probes;     // 发了多少步不合法的着法
+    atomic<int> mismatched; // 配对结果不对：同一房间的座位不是正好一个 1 一个 2
+};
+
+static double Ms(Clock::time_point start)
+{
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// 服务器的常驻内存（KB），读不到返回 -1
+static long ServerRssKb(int pid)
+{
+    if (pid <= 0)
+        return -1;
+    ifstream status("/proc/" + to_string(pid) + "/status");
+    string key;
+    while (status >> key)
+    {
+        if (key == "VmRSS:")
+        {
+            long kb;
+            status >> kb;
+            return kb;
+        }
+    }
+    return -1;
+}
+
+// 登录：所有线程一起抢着登录，配对结果以服务器返回的房间号和座位号为准
+static void JoinThread(LoadShared *shared, vector<double> *latencies, vector<pair<int, int>> *joined, string tag)
+{
+    httplib::Client client(shared->address);
+    client.set_keep_alive(true);
+    client.set_tcp_nodelay(true); // 保持连接时不关 Nagle，每个请求要多等 40 ms 的延迟确认
+    while (true)
+    {
+        int k = shared->nextJoin++;
+        if (k >= 2 * shared->matches)
+            break;
+        auto start = Clock::now();
+        httplib::Result res = client.Post("/match", "load" + tag + "_" + to_string(k), "text/plain");
+        latencies->push_back(Ms(start));
+        if (!res || res->status != 200 || !res->has_header("Room-ID"))
+        {
+            shared->errors++;
+            continue;
+        }
+        joined->push_back({stoi(res->get_header_value("Room-ID")), stoi(res->body)});
+    }
+}
+
+static string MoveBody(const Move &move, size_t seq)
+{
+    uint8_t packet[MOVE_PACKET_BYTES];
+    EncodeMovePacket(move, (uint16_t)seq, packet);
+    return string((const char *)packet, MOVE_PACKET_BYTES);
+}
+
+// 走棋：这个线程负责的房间一个一个轮着走，每个房间每轮走一步（轮到谁就扮演谁）
+static void PlayThread(LoadShared *shared, int index, vector<double> *latencies)
+{
+    httplib::Client client(shared->address);
+    client.set_keep_alive(true);
+    client.set_tcp_nodelay(true); // 保持连接时不关 Nagle，每个请求要多等 40 ms 的延迟确认
+    client.set_read_timeout(60, 0);
+    for (int ply = 0; ply < shared->moves; ply++)
+    {
+        int seat = ply % 2 + 1;
+        for (int m = index; m < shared->matches; m += shared->threads)
+        {
+            LoadMatch &room = shared->rooms[m];
+            if ((int)room.seen != ply || ply >= room.script->plies) // 前面出过错，或者这一局已经下完
+                continue;
+
+            auto start = Clock::now();
+            httplib::Result wait = client.Get("/wait?since=" + to_string(room.seen), {{"Client-ID", to_string(seat)}, {"Room-ID", room.roomId}});
+            latencies->push_back(Ms(start));
+            if (!wait || wait->status != 200)
+            {
+                shared->errors++;
+                continue;
+            }
+            httplib::Headers headers = {{"Client-ID", to_string(seat)}, {"Room-ID", room.roomId}};
+
+            if (ply % ILLEGAL_EVERY == ILLEGAL_EVERY / 2) // 原地不动：永远不合法
+            {
+                int me = room.state.turn;
+                Move stay = {(uint8_t)MOVE_PAWN, (int8_t)room.state.x[me], (int8_t)room.state.y[me], false};
+                start = Clock::now();
+                httplib::Result res = client.Post("/message", headers, MoveBody(stay, room.seen), "application/octet-stream");
+                latencies->push_back(Ms(start));
+                shared->probes++;
+                if (!res)
+                {
+                    shared->errors++;
+                    continue;
+                }
+                if (res->status == 200)
+                {
+                    shared->accepted++;
+                    continue;
+                }
+            }
+
+            const Move &move = room.script->moves[ply];
+            start = Clock::now();
+            httplib::Result res = client.Post("/message", headers, MoveBody(move, room.seen), "application/octet-stream");
+            latencies->push_back(Ms(start));
+            if (!res)
+                shared->errors++;
+            else if (res->status != 200)
+                shared->rejected++;
+            else
+            {
+                ApplyMove(room.state, move);
+                room.seen++;
+            }
+        }
+    }
+}
+
+static void PrintLatencies(const char *name, vector<vector<double>> &perThread, double seconds)
+{
+    vector<double> all;
+    for (auto &l : perThread)
+        all.insert(all.end(), l.begin(), l.end());
+    if (all.empty())
+        return;
+    sort(all.begin(), all.end());
+    auto at = [&](double q)
+    { return all[min(all.size() - 1, (size_t)(q * all.size()))]; };
+    printf("%-6s %8zu requests in %6.2f s  %8.0f req/s  p50 %.2f ms  p90 %.2f ms  p99 %.2f ms  max %.2f ms\n",
+           name, all.size(), seconds, all.size() / seconds, at(0.5), at(0.9), at(0.99), all.back());
+}
+
+int main(int argc, char **argv)
+{
+    LoadShared shared;
+    shared.matches = argc > 1 ? atoi(argv[1]) : 1000;
+    shared.moves = argc > 2 ? atoi(argv[2]) : 20;
+    shared.threads = argc > 3 ? atoi(argv[3]) : 8;
+    shared.address = argc > 4 ? argv[4] : "127.0.0.1:25565";
+    int serverPid = argc > 5 ? atoi(argv[5]) : 0;
+    shared.nextJoin.store(0);
+    shared.errors.store(0);
+    shared.rejected.store(0);
+    shared.accepted.store(0);
+    shared.probes.store(0);
+    shared.mismatched.store(0);
+    string tag = to_string(Clock::now().time_since_epoch().count()); // 名字每次不同，否则会回到上一次的房间
+
+    // 事先下好的对局：双方都用随机策略，前几十步大多是放墙
+    vector<GameRecord> scripts(SCRIPT_COUNT);
+    PolicyConfig players[2];
+    ParsePolicy("random", players[0]);
+    ParsePolicy("random", players[1]);
+    PolicyWorker worker;
+    InitPolicyWorker(worker, 1);
+    int scriptWalls = 0, scriptPlies = 0;
+    for (int k = 0; k < SCRIPT_COUNT; k++)
+    {
+        PlayGame(players, worker, k + 1, scripts[k]);
+        for (int p = 0; p < min(scripts[k].plies, shared.moves); p++)
+        {
+            scriptWalls += scripts[k].moves[p].type == MOVE_WALL;
+            scriptPlies++;
+        }
+    }
+
+    long rssBefore = ServerRssKb(serverPid);
+
+    vector<vector<double>> joinLatencies(shared.threads), playLatencies(shared.threads);
+    vector<vector<pair<int, int>>> joined(shared.threads); // (房间号, 座位号)
+    vector<thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < shared.threads; t++)
+        workers.emplace_back(JoinThread, &shared, &joinLatencies[t], &joined[t], tag);
+    for (auto &w : workers)
+        w.join();
+    double joinSeconds = Ms(start) / 1000;
+
+    // 按房间号汇总座位：每个房间应该正好坐了 1 号和 2 号
+    vector<pair<int, int>> seats;
+    for (auto &j : joined)
+        seats.insert(seats.end(), j.begin(), j.end());
+    sort(seats.begin(), seats.end());
+    shared.rooms.clear();
+    for (size_t k = 0; k < seats.size();)
+    {
+        size_t end = k;
+        while (end < seats.size() && seats[end].first == seats[k].first)
+            end++;
+        if (end - k == 2 && seats[k].second == 1 && seats[k + 1].second == 2)
+        {
+            shared.rooms.push_back({to_string(seats[k].first), &scripts[shared.rooms.size() % SCRIPT_COUNT], {}, 0});
+            NewGame(shared.rooms.back().state);
+        }
+        else if (end - k != 1 || seats[k].second != 1) // 最后一个人可能还在等对手（其他人也在登录时）
+            shared.mismatched++;
+        k = end;
+    }
+    shared.matches = (int)shared.rooms.size();
+    long rssJoined = ServerRssKb(serverPid);
+
+    workers.clear();
+    start = Clock::now();
+    for (int t = 0; t < shared.threads; t++)
+        workers.emplace_back(PlayThread, &shared, t, &playLatencies[t]);
+    for (auto &w : workers)
+        w.join();
+    double playSeconds = Ms(start) / 1000;
+    long rssPlayed = ServerRssKb(serverPid);
+
+    printf("%d matches, %d moves each, %d client threads\n", shared.matches, shared.moves, shared.threads);
+    PrintLatencies("join", joinLatencies, joinSeconds);
+    PrintLatencies("play", playLatencies, playSeconds);
+    printf("scripted moves: %.0f%% walls\n", scriptPlies > 0 ? 100.0 * scriptWalls / scriptPlies : 0.0);
+    printf("errors %d  legal moves rejected %d  illegal moves accepted %d / %d  mispaired matches %d\n",
+           shared.errors.load(), shared.rejected.load(), shared.accepted.load(), shared.probes.load(), shared.mismatched.load());
+    httplib::Client statsClient(shared.address);
+    httplib::Result stats = statsClient.Get("/stats");
+    if (stats && stats->status == 200)
+        printf("server /stats:\n%s", stats->body.c_str());
+    if (rssBefore >= 0)
+        printf("server RSS  before %ld KB  after joins %ld KB  after play %ld KB  (%.2f KB per match)\n",
+               rssBefore, rssJoined, rssPlayed, shared.matches > 0 ? (double)(rssPlayed - rssBefore) / shared.matches : 0.0);
+    return shared.errors.load() + shared.rejected.load() + shared.accepted.load() + shared.mismatched.load() > 0 ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+// 着法延迟测量：同一个进程里开两个无界面客户端（A、B）对下，记录一方 POST /message 到另一方拿到这条消息的时间
+// 两种模式：
+//   poll  原来的做法：每 1500 ms 查一次 /turn，轮到自己再查 /messages
+//   wait  长轮询 /wait?since=N：对手一走完服务器马上返回
+// 双方收到回合就立刻走（来回走同一格），所以测到的只是网络和轮询带来的延迟；
+// 真正的客户端里 Game() 每帧读一次 GameMessage，上屏还要再加最多一帧（60 FPS 约 16.7 ms）
+//
+// 编译（在 Quoridor/Networking 目录下）：
+//   g++ -O2 -std=c++17 -I../Core/include tools/move_latency.cpp ../Core/src/*.cpp -o move_latency -lpthread
+// 运行（两个玩家登录后服务器会把他们配到同一个房间，不用重启 server）：
+//   ./move_latency [poll | wait] [着法数] [服务器地址]
+//   例如 ./move_latency wait 200 127.0.0.1:25565
+
+#include "../thirdparty/httplib.h"
+#include "game_state.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const int POLL_INTERVAL_MS = 1500; // 原来 fetchMessageThread 的轮询间隔
+
+struct LatencyShared
+{
+    string address;
+    string roomId;                // 服务器分配的房间号
+    bool longPoll;
+    int moves;                    // 总共要走的步数
+    atomic<int> sent;             // 已经发出的步数
+    atomic<long long> lastPostNs; // 最近一次 POST /message 的时间
+    vector<double> latencies;     // 每一步从发出到对手收到的毫秒数（双方轮流写，不会同时）
+};
+
+static long long NowNs()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// 和客户端一样的二进制着法
+static string MoveBody(int x, int y, int seq)
+{
+    uint8_t packet[MOVE_PACKET_BYTES];
+    EncodeMovePacket(Move{(uint8_t)MOVE_PAWN, (int8_t)x, (int8_t)y, false}, (uint16_t)seq, packet);
+    return string((const char *)packet, MOVE_PACKET_BYTES);
+}
+
+static void RecordReceive(LatencyShared &shared)
+{
+    shared.latencies.push_back((NowNs() - shared.lastPostNs.load()) / 1e6);
+}
+
+// 轮到自己就在起点和前一格之间来回走
+static bool SendMove(httplib::Client &client, LatencyShared &shared, int clientId, int &x, int y)
+{
+    int homeX = clientId == 1 ? 0 : 8;
+    x = x == homeX ? (clientId == 1 ? 1 : 7) : homeX;
+    httplib::Headers headers = {{"Client-ID", to_string(clientId)}, {"Room-ID", shared.roomId}};
+    int seq = shared.sent++; // 双方轮流走，已经发出的步数就是这一步的序号
+    shared.lastPostNs.store(NowNs());
+    httplib::Result res = client.Post("/message", headers, MoveBody(x, y, seq), "application/octet-stream");
+    return res && res->status == 200;
+}
+
+static void PlayerThread(LatencyShared *shared, int clientId)
+{
+    httplib::Client client(shared->address);
+    client.set_read_timeout(60, 0);
+    int x = clientId == 1 ? 0 : 8, y = 4;
+    string lastMessage = "No messages yet.";
+    size_t seen = 0;
+
+    while (shared->sent.load() < shared->moves)
+    {
+        int turn;
+        string message;
+        if (shared->longPoll)
+        {
+            httplib::Result res = client.Get("/wait?since=" + to_string(seen), {{"Client-ID", to_string(clientId)}, {"Room-ID", shared->roomId}});
+            if (!res || res->status != 200)
+                break;
+            seen = stoul(res->get_header_value("Message-Count"));
+            turn = stoi(res->get_header_value("Turn"));
+            message = res->body.empty() ? lastMessage : res->body; // 返回的是 since 之后的着法，轮到自己时可能是空的
+        }
+        else
+        {
+            httplib::Result turnRes = client.Get("/turn", {{"Room-ID", shared->roomId}});
+            if (!turnRes || turnRes->status != 200)
+                break;
+            turn = stoi(turnRes->body);
+            message = lastMessage;
+            if (turn == clientId)
+            {
+                httplib::Result messageRes = client.Get("/messages", {{"Room-ID", shared->roomId}});
+                if (messageRes && messageRes->status == 200)
+                    message = messageRes->body;
+            }
+        }
+
+        if (message != lastMessage)
+        {
+            lastMessage = message;
+            RecordReceive(*shared);
+        }
+        if (turn == clientId && shared->sent.load() < shared->moves)
+        {
+            if (!SendMove(client, *shared, clientId, x, y))
+                break;
+            seen++;
+        }
+        if (!shared->longPoll)
+            this_thread::sleep_for(chrono::milliseconds(POLL_INTERVAL_MS));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    LatencyShared shared;
+    shared.longPoll = !(argc > 1 && string(argv[1]) == "poll");
+    shared.moves = argc > 2 ? atoi(argv[2]) : 20;
+    shared.address = argc > 3 ? argv[3] : "127.0.0.1:25565";
+    shared.sent.store(0);
+    shared.lastPostNs.store(0);
+
+    // 登录两个玩家，等 /ready
+    httplib::Client client(shared.address);
+    string tag = to_string(NowNs()); // 名字每次不同，否则会回到上一次的房间
+    httplib::Result a = client.Post("/login", "latencyA" + tag, "text/plain");
+    httplib::Result b = client.Post("/login", "latencyB" + tag, "text/plain");
+    if (!a || !b || a->body != "1" || b->body != "2" || a->get_header_value("Room-ID") != b->get_header_value("Room-ID"))
+    {
+        printf("login failed (someone else is waiting for an opponent on this server)\n");
+        return 1;
+    }
+    shared.roomId = a->get_header_value("Room-ID");
+    httplib::Result ready = client.Get("/ready", {{"Client-ID", "1"}, {"Room-ID", shared.roomId}});
+    if (!ready || ready->body == "Waiting")
+    {
+        printf("server not ready\n");
+        return 1;
+    }
+
+    auto start = Clock::now();
+    thread playerA(PlayerThread, &shared, 1);
+    thread playerB(PlayerThread, &shared, 2);
+    playerA.join();
+    playerB.join();
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<double> &l = shared.latencies;
+    if (l.empty())
+    {
+        printf("no moves received\n");
+        return 1;
+    }
+    sort(l.begin(), l.end());
+    double sum = 0;
+    for (double v : l)
+        sum += v;
+    printf("%s: %zu moves in %.1f s\n", shared.longPoll ? "long poll (/wait)" : "polling every 1500 ms (/turn + /messages)", l.size(), seconds);
+    printf("  move-to-client latency  mean %.2f ms  median %.2f ms  p95 %.2f ms  max %.2f ms\n",
+           sum / l.size(), l[l.size() / 2], l[min(l.size() - 1, l.size() * 95 / 100)], l.back());
+    return 0;
+}
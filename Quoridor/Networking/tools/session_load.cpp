@@ -0,0 +1,320 @@
+// 在线人数测试：一批一批地加玩家，每个玩家一条保持连接的 HTTP 连接，登录以后什么都不做（像在想下一步）
+// 每个房间的 1 号座位只是连着，2 号座位挂着一个 /wait（等 1 号走棋），挂满 25 秒服务器回复以后马上再挂一个
+// 每加一批：从 /proc/<pid>/status 读服务器的内存，算出每个玩家占多少；某个玩家登录超过 LOGIN_TIMEOUT_MS 还没回复就停
+// （httplib 后端一个连接占一个线程，线程用完以后新来的人要排队；epoll 后端挂着的连接不占线程）
+// 最后在一部分房间里让 1 号走一步，量 2 号挂着的 /wait 多久收到这一步，确认服务器在这么多人在线时还能正常走棋
+//
+// 编译（在 Quoridor/Networking 目录下）：
+//   g++ -O2 -std=c++17 -I../Core/include tools/session_load.cpp ../Core/src/*.cpp -o session_load -lpthread
+// 运行：
+//   ./session_load [最多玩家数] [每批人数] [服务器地址] [服务器进程号]
+//   例如 ./server --epoll > /dev/null & ./session_load 10000 1000 127.0.0.1:25565 $!
+
+#include "game_state.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const int LOGIN_TIMEOUT_MS = 2000; // 登录超过这么久没回复，就当服务器已经接不下了
+const int REPLY_TIMEOUT_MS = 5000; // 其他请求最多等这么久
+const int SAMPLE_ROOMS = 50;       // 最后走一步的房间数
+
+struct Session
+{
+    int fd = -1;
+    string buffer;  // 收到还没处理的字节
+    string roomId;
+    int seat = 0;
+    bool parked = false; // 2 号座位：有一个 /wait 在服务器上挂着
+};
+
+struct Reply
+{
+    int status = 0;
+    string head; // 状态行和响应头
+    string body;
+};
+
+static double Ms(Clock::time_point start)
+{
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// 服务器的常驻内存（KB），读不到返回 -1
+static long ServerRssKb(int pid)
+{
+    if (pid <= 0)
+        return -1;
+    ifstream status("/proc/" + to_string(pid) + "/status");
+    string key;
+    while (status >> key)
+    {
+        if (key == "VmRSS:")
+        {
+            long kb;
+            status >> kb;
+            return kb;
+        }
+    }
+    return -1;
+}
+
+static int Connect(const sockaddr_in &address)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    int yes = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    if (connect(fd, (const sockaddr *)&address, sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool Send(Session &session, const string &method, const string &target, const string &headers, const string &body)
+{
+    string request = method + " " + target + " HTTP/1.1\r\nHost: load\r\n" + headers +
+                     "Content-Length: " + to_string(body.size()) + "\r\n\r\n" + body;
+    size_t written = 0;
+    while (written < request.size())
+    {
+        ssize_t n = send(session.fd, request.data() + written, request.size() - written, MSG_NOSIGNAL);
+        if (n <= 0)
+            return false;
+        written += (size_t)n;
+    }
+    return true;
+}
+
+// 等一个完整的回复（最多 timeoutMs 毫秒），超时或者连接断了返回 false
+static bool Receive(Session &session, Reply &reply, int timeoutMs)
+{
+    auto start = Clock::now();
+    while (true)
+    {
+        size_t headEnd = session.buffer.find("\r\n\r\n");
+        if (headEnd != string::npos)
+        {
+            reply.head = session.buffer.substr(0, headEnd);
+            size_t length = 0;
+            size_t found = reply.head.find("Content-Length: ");
+            if (found != string::npos)
+                length = (size_t)atoll(reply.head.c_str() + found + 16);
+            if (session.buffer.size() >= headEnd + 4 + length)
+            {
+                reply.status = atoi(reply.head.c_str() + 9); // "HTTP/1.1 200 OK"
+                reply.body = session.buffer.substr(headEnd + 4, length);
+                session.buffer.erase(0, headEnd + 4 + length);
+                return true;
+            }
+        }
+        int left = timeoutMs - (int)Ms(start);
+        pollfd ready = {session.fd, POLLIN, 0};
+        if (left <= 0 || poll(&ready, 1, left) <= 0)
+            return false;
+        char chunk[4096];
+        ssize_t n = recv(session.fd, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            return false;
+        session.buffer.append(chunk, (size_t)n);
+    }
+}
+
+static string Header(const Reply &reply, const string &name)
+{
+    size_t found = reply.head.find("\r\n" + name + ": ");
+    if (found == string::npos)
+        return "";
+    size_t start = found + name.size() + 4;
+    return reply.head.substr(start, reply.head.find("\r\n", start) - start);
+}
+
+static string SeatHeaders(const Session &session)
+{
+    return "Client-ID: " + to_string(session.seat) + "\r\nRoom-ID: " + session.roomId + "\r\n";
+}
+
+static bool Park(Session &session, size_t since)
+{
+    session.parked = Send(session, "GET", "/wait?since=" + to_string(since), SeatHeaders(session), "");
+    return session.parked;
+}
+
+static void Disconnect(Session &session)
+{
+    if (session.fd >= 0)
+        close(session.fd);
+    session.fd = -1;
+    session.buffer.clear();
+    session.parked = false;
+}
+
+// 不等待地看一遍所有连接：挂满时间回来的 /wait 马上再挂，被服务器关掉的连接记下来
+static void Drain(vector<Session> &sessions, int &rewaits, int &dropped)
+{
+    vector<pollfd> fds;
+    vector<size_t> owners;
+    for (size_t k = 0; k < sessions.size(); k++)
+    {
+        if (sessions[k].fd >= 0)
+        {
+            fds.push_back({sessions[k].fd, POLLIN, 0});
+            owners.push_back(k);
+        }
+    }
+    if (fds.empty() || poll(fds.data(), fds.size(), 0) <= 0)
+        return;
+    for (size_t i = 0; i < fds.size(); i++)
+    {
+        if (!fds[i].revents)
+            continue;
+        Session &session = sessions[owners[i]];
+        Reply reply;
+        if (session.parked && Receive(session, reply, REPLY_TIMEOUT_MS) && reply.status == 200 && Park(session, 0))
+        {
+            rewaits++;
+            continue;
+        }
+        Disconnect(session); // 空闲的 1 号座位被服务器关掉了（httplib 的保持连接超时），或者出错
+        dropped++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int maxPlayers = argc > 1 ? atoi(argv[1]) : 10000;
+    int batch = max(2, argc > 2 ? atoi(argv[2]) : 1000) / 2 * 2; // 双数，每批正好配满
+    string address = argc > 3 ? argv[3] : "127.0.0.1:25565";
+    int serverPid = argc > 4 ? atoi(argv[4]) : 0;
+
+    sockaddr_in server = {};
+    server.sin_family = AF_INET;
+    size_t colon = address.find(':');
+    server.sin_port = htons((uint16_t)(colon == string::npos ? 25565 : atoi(address.c_str() + colon + 1)));
+    inet_pton(AF_INET, address.substr(0, colon).c_str(), &server.sin_addr);
+
+    rlimit limit; // 每个玩家一个 fd
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+        if ((long)limit.rlim_cur < maxPlayers + 100)
+            printf("fd limit %ld, at most %ld players from this process\n", (long)limit.rlim_cur, (long)limit.rlim_cur - 100);
+    }
+
+    string tag = to_string(Clock::now().time_since_epoch().count()); // 名字每次不同
+    vector<Session> sessions;
+    sessions.reserve(maxPlayers);
+    long rssBefore = ServerRssKb(serverPid);
+    int rewaits = 0, dropped = 0, errors = 0;
+    bool full = false;
+    int capacity = 0; // 登录都在时限内完成的最多玩家数
+
+    printf("%8s %8s %8s %10s %12s %12s %12s\n", "players", "rooms", "parked", "RSS KB", "KB/player", "login p50", "login max");
+    while ((int)sessions.size() < maxPlayers && !full)
+    {
+        vector<double> logins;
+        for (int k = 0; k < batch && (int)sessions.size() < maxPlayers; k++)
+        {
+            Session session;
+            session.fd = Connect(server);
+            auto start = Clock::now();
+            Reply reply;
+            if (session.fd < 0 || !Send(session, "POST", "/login", "", "idle" + tag + "_" + to_string(sessions.size())) ||
+                !Receive(session, reply, LOGIN_TIMEOUT_MS) || reply.status != 200)
+            {
+                Disconnect(session);
+                full = true;
+                break;
+            }
+            logins.push_back(Ms(start));
+            session.roomId = Header(reply, "Room-ID");
+            session.seat = atoi(reply.body.c_str());
+            if (session.seat == 2 && !Park(session, 0))
+                errors++;
+            sessions.push_back(move(session));
+        }
+        if (!full)
+            capacity = (int)sessions.size();
+        Drain(sessions, rewaits, dropped);
+
+        int parked = 0;
+        for (const Session &session : sessions)
+            parked += session.parked;
+        long rss = ServerRssKb(serverPid);
+        sort(logins.begin(), logins.end());
+        printf("%8zu %8zu %8d %10ld %12.2f %9.2f ms %9.2f ms\n", sessions.size(), sessions.size() / 2, parked, rss,
+               rss >= 0 && !sessions.empty() ? (double)(rss - rssBefore) / sessions.size() : 0.0,
+               logins.empty() ? 0.0 : logins[logins.size() / 2], logins.empty() ? 0.0 : logins.back());
+    }
+
+    // 走一步：1 号座位发一步合法的兵步，量 2 号挂着的 /wait 多久收到
+    GameState state;
+    NewGame(state);
+    Move moves[MAX_MOVES];
+    int count = GenerateMoves(state, moves);
+    Move step = moves[0];
+    for (int k = 0; k < count; k++)
+    {
+        if (moves[k].type == MOVE_PAWN)
+        {
+            step = moves[k];
+            break;
+        }
+    }
+    uint8_t packet[MOVE_PACKET_BYTES];
+    EncodeMovePacket(step, 0, packet);
+    string body((const char *)packet, MOVE_PACKET_BYTES);
+
+    vector<double> wakes;
+    int sampleFailures = 0;
+    for (size_t k = 0; k + 1 < sessions.size() && (int)(wakes.size()) + sampleFailures < SAMPLE_ROOMS; k += 2)
+    {
+        Session &first = sessions[k], &second = sessions[k + 1];
+        if (first.seat != 1 || second.seat != 2 || first.roomId != second.roomId || !second.parked)
+            continue;
+        if (first.fd < 0) // 服务器关掉了空闲连接：像客户端一样重连
+            first.fd = Connect(server);
+        auto start = Clock::now();
+        Reply sent, woken;
+        if (first.fd < 0 || !Send(first, "POST", "/message", SeatHeaders(first), body) ||
+            !Receive(first, sent, REPLY_TIMEOUT_MS) || sent.status != 200 ||
+            !Receive(second, woken, REPLY_TIMEOUT_MS) || woken.status != 200 || Header(woken, "Message-Count") != "1")
+        {
+            sampleFailures++;
+            continue;
+        }
+        wakes.push_back(Ms(start));
+    }
+
+    long rss = ServerRssKb(serverPid);
+    printf("\n%d players online%s, %d /wait re-sent after timing out, %d idle connections closed by the server, %d errors\n",
+           capacity, full ? " (next login timed out)" : "", rewaits, dropped, errors);
+    if (rss >= 0 && capacity > 0)
+        printf("server RSS %ld KB -> %ld KB: %.2f KB per player\n", rssBefore, rss, (double)(rss - rssBefore) / capacity);
+    sort(wakes.begin(), wakes.end());
+    if (!wakes.empty())
+        printf("move -> opponent's /wait: %zu rooms  p50 %.2f ms  max %.2f ms\n", wakes.size(), wakes[wakes.size() / 2], wakes.back());
+    printf("rooms where the move did not get through: %d\n", sampleFailures);
+
+    for (Session &session : sessions)
+        Disconnect(session);
+    return sampleFailures + errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,353 @@
+// 传输方式对比：同一台服务器上分别用 HTTP（/login + /wait 长轮询 + /message）和 TCP 长连接（frame.h）下 N 局
+// 每局按一局事先用随机策略下好的对局走前 P 步，同时进行 C 局，每局两个玩家各一个线程
+// 输出（每种传输方式一行）：
+//   延迟  一方发出着法到对手收到的毫秒数（平均、中位数、p99、最大）
+//   吞吐  每秒步数
+//   CPU   给出服务器进程号时，从 /proc/<pid>/stat 读服务器用掉的 CPU 时间，折算成每 1000 局多少 CPU 秒
+//
+// 编译（在 Quoridor/Networking 目录下）：
+//   g++ -O2 -std=c++17 -Iinclude -I../Core/include tools/transport_bench.cpp ../Core/src/*.cpp -o transport_bench -lpthread
+// 运行（服务器默认 TCP 长连接端口 = HTTP 端口 + 1）：
+//   ./transport_bench [both | http | tcp] [局数] [每局步数] [同时进行的局数] [服务器地址] [服务器进程号]
+//   例如 ./server & ./transport_bench both 1000 40 16 127.0.0.1:25565 $!
+
+#include "../thirdparty/httplib.h"
+#include "frame.h"
+#include "game_state.h"
+#include "policy.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const int SCRIPT_COUNT = 16;
+
+struct BenchMatch
+{
+    const GameRecord *script;
+    int plies;                        // 这一局走几步
+    vector<atomic<long long>> sentNs; // 第 k 步发出的时间
+    BenchMatch(const GameRecord *s, int p) : script(s), plies(p), sentNs(p) {}
+};
+
+struct BenchShared
+{
+    string host;
+    int httpPort;
+    bool tcp;
+    int matches;
+    int plies;
+    vector<GameRecord> scripts;
+    atomic<int> nextMatch;
+    atomic<int> errors;
+    mutex joinMutex; // 两个玩家连着登录，保证配进同一个房间
+    mutex latencyMutex;
+    vector<double> latencies;
+    string tag;      // 名字每次不同，否则会回到上一次的房间
+};
+
+static long long NowNs()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// 服务器进程用掉的 CPU 秒数（用户态 + 内核态），读不到返回 -1
+static double ServerCpuSeconds(int pid)
+{
+    if (pid <= 0)
+        return -1;
+    ifstream stat("/proc/" + to_string(pid) + "/stat");
+    string text((istreambuf_iterator<char>(stat)), istreambuf_iterator<char>());
+    size_t paren = text.rfind(')');
+    if (paren == string::npos)
+        return -1;
+    vector<string> fields;
+    size_t pos = paren + 2;
+    while (pos < text.size())
+    {
+        size_t end = text.find(' ', pos);
+        fields.push_back(text.substr(pos, end == string::npos ? string::npos : end - pos));
+        if (end == string::npos)
+            break;
+        pos = end + 1;
+    }
+    if (fields.size() < 13)
+        return -1;
+    return (stod(fields[11]) + stod(fields[12])) / sysconf(_SC_CLK_TCK); // 第 14、15 个字段 utime、stime
+}
+
+static string Packet(const Move &move, int seq)
+{
+    uint8_t packet[MOVE_PACKET_BYTES];
+    EncodeMovePacket(move, (uint16_t)seq, packet);
+    return string((const char *)packet, MOVE_PACKET_BYTES);
+}
+
+static void RecordLatency(BenchShared &shared, BenchMatch &match, int seq)
+{
+    double ms = (NowNs() - match.sentNs[seq].load()) / 1e6;
+    lock_guard<mutex> lock(shared.latencyMutex);
+    shared.latencies.push_back(ms);
+}
+
+// ------------------------------HTTP------------------------------
+
+static void HttpPlayer(BenchShared *shared, BenchMatch *match, httplib::Client *client, string roomId, int seat)
+{
+    httplib::Headers headers = {{"Client-ID", to_string(seat)}, {"Room-ID", roomId}};
+    int seen = 0;
+    while (seen < match->plies)
+    {
+        httplib::Result wait = client->Get("/wait?since=" + to_string(seen), headers);
+        if (!wait || wait->status != 200)
+        {
+            shared->errors++;
+            return;
+        }
+        const string &body = wait->body;
+        for (size_t offset = 0; offset + MOVE_PACKET_BYTES <= body.size(); offset += MOVE_PACKET_BYTES)
+        {
+            int seq = seen + (int)(offset / MOVE_PACKET_BYTES);
+            if (seq % 2 + 1 != seat && seq < match->plies)
+                RecordLatency(*shared, *match, seq);
+        }
+        seen = stoi(wait->get_header_value("Message-Count"));
+        if (stoi(wait->get_header_value("Turn")) == seat && seen < match->plies)
+        {
+            match->sentNs[seen].store(NowNs());
+            httplib::Result res = client->Post("/message", headers, Packet(match->script->moves[seen], seen), "application/octet-stream");
+            if (!res || res->status != 200)
+            {
+                shared->errors++;
+                return;
+            }
+            seen++;
+        }
+    }
+}
+
+static void HttpMatch(BenchShared *shared, BenchMatch *match, int index)
+{
+    string address = shared->host + ":" + to_string(shared->httpPort);
+    httplib::Client a(address), b(address);
+    for (httplib::Client *client : {&a, &b})
+    {
+        client->set_keep_alive(true);
+        client->set_tcp_nodelay(true);
+        client->set_read_timeout(60, 0);
+    }
+    string roomId;
+    {
+        lock_guard<mutex> lock(shared->joinMutex);
+        httplib::Result ra = a.Post("/login", "benchA" + shared->tag + "_" + to_string(index), "text/plain");
+        httplib::Result rb = b.Post("/login", "benchB" + shared->tag + "_" + to_string(index), "text/plain");
+        if (!ra || !rb || ra->body != "1" || rb->body != "2" || ra->get_header_value("Room-ID") != rb->get_header_value("Room-ID"))
+        {
+            shared->errors++;
+            return;
+        }
+        roomId = ra->get_header_value("Room-ID");
+    }
+    thread playerA(HttpPlayer, shared, match, &a, roomId, 1);
+    thread playerB(HttpPlayer, shared, match, &b, roomId, 2);
+    playerA.join();
+    playerB.join();
+}
+
+// ------------------------------TCP 长连接------------------------------
+
+static int Connect(const BenchShared &shared)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)(shared.httpPort + 1));
+    inet_pton(AF_INET, shared.host.c_str(), &address.sin_addr);
+    if (connect(fd, (sockaddr *)&address, sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    int yes = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    return fd;
+}
+
+static bool SendFrame(int fd, uint8_t type, const string &payload)
+{
+    string frame;
+    AppendFrame(frame, type, payload);
+    return send(fd, frame.data(), frame.size(), MSG_NOSIGNAL) == (ssize_t)frame.size();
+}
+
+static bool ReadFrame(int fd, string &buffer, uint8_t &type, string &payload)
+{
+    while (true)
+    {
+        size_t offset = 0;
+        bool bad = false;
+        if (NextFrame(buffer, offset, type, payload, bad))
+        {
+            buffer.erase(0, offset);
+            return true;
+        }
+        if (bad)
+            return false;
+        char chunk[4096];
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            return false;
+        buffer.append(chunk, (size_t)n);
+    }
+}
+
+static void TcpPlayer(BenchShared *shared, BenchMatch *match, int fd, string buffer, int seat)
+{
+    string payload;
+    uint8_t type;
+    int received = 0;
+    auto sendNext = [&]
+    {
+        match->sentNs[received].store(NowNs());
+        return SendFrame(fd, FRAME_MOVE, Packet(match->script->moves[received], received));
+    };
+    while (received < match->plies && ReadFrame(fd, buffer, type, payload))
+    {
+        if (type == FRAME_START && seat == 1 && !sendNext())
+            break;
+        if (type == FRAME_REJECT)
+            break;
+        if (type != FRAME_MOVE)
+            continue;
+        int seq = received++;
+        if (seq % 2 + 1 != seat)
+            RecordLatency(*shared, *match, seq);
+        if ((uint8_t)payload[MOVE_PACKET_BYTES] == seat && received < match->plies && !sendNext())
+            break;
+    }
+    if (received < match->plies)
+        shared->errors++;
+    close(fd);
+}
+
+static void TcpMatch(BenchShared *shared, BenchMatch *match, int index)
+{
+    int fds[2];
+    string buffers[2];
+    {
+        lock_guard<mutex> lock(shared->joinMutex);
+        for (int s = 0; s < 2; s++)
+        {
+            fds[s] = Connect(*shared);
+            string payload;
+            uint8_t type = 0;
+            if (fds[s] < 0 || !SendFrame(fds[s], FRAME_JOIN, string(s == 0 ? "benchA" : "benchB") + shared->tag + "_" + to_string(index)) ||
+                !ReadFrame(fds[s], buffers[s], type, payload) || type != FRAME_SEAT || payload.size() != 5 || payload[4] != s + 1)
+            {
+                shared->errors++;
+                for (int k = 0; k <= s; k++)
+                    if (fds[k] >= 0)
+                        close(fds[k]);
+                return;
+            }
+        }
+    }
+    thread playerA(TcpPlayer, shared, match, fds[0], buffers[0], 1);
+    thread playerB(TcpPlayer, shared, match, fds[1], buffers[1], 2);
+    playerA.join();
+    playerB.join();
+}
+
+// ------------------------------------------------------------
+
+static void SlotThread(BenchShared *shared)
+{
+    while (true)
+    {
+        int index = shared->nextMatch++;
+        if (index >= shared->matches)
+            break;
+        const GameRecord *script = &shared->scripts[index % SCRIPT_COUNT];
+        BenchMatch match(script, min(shared->plies, script->plies));
+        if (shared->tcp)
+            TcpMatch(shared, &match, index);
+        else
+            HttpMatch(shared, &match, index);
+    }
+}
+
+static void Run(BenchShared &shared, bool tcp, int concurrent, int serverPid)
+{
+    shared.tcp = tcp;
+    shared.nextMatch.store(0);
+    shared.errors.store(0);
+    shared.latencies.clear();
+    shared.tag = to_string(NowNs());
+
+    double cpuBefore = ServerCpuSeconds(serverPid);
+    auto start = Clock::now();
+    vector<thread> slots;
+    for (int c = 0; c < concurrent; c++)
+        slots.emplace_back(SlotThread, &shared);
+    for (auto &slot : slots)
+        slot.join();
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    double cpu = ServerCpuSeconds(serverPid) - cpuBefore;
+
+    vector<double> &l = shared.latencies;
+    sort(l.begin(), l.end());
+    double sum = 0;
+    for (double v : l)
+        sum += v;
+    auto at = [&](double q)
+    { return l.empty() ? 0.0 : l[min(l.size() - 1, (size_t)(q * l.size()))]; };
+    printf("%-5s %6zu moves %6.2f s %8.0f moves/s  latency mean %.3f  p50 %.3f  p99 %.3f  max %.3f ms  errors %d",
+           tcp ? "tcp" : "http", l.size(), seconds, l.size() / seconds, l.empty() ? 0.0 : sum / l.size(), at(0.5), at(0.99), l.empty() ? 0.0 : l.back(), shared.errors.load());
+    if (cpuBefore >= 0)
+        printf("  server CPU %.2f s (%.2f s per 1000 matches, %.1f us per move)", cpu, cpu * 1000 / shared.matches, l.empty() ? 0.0 : cpu * 1e6 / l.size());
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    string mode = argc > 1 ? argv[1] : "both";
+    BenchShared shared;
+    shared.matches = argc > 2 ? atoi(argv[2]) : 1000;
+    shared.plies = argc > 3 ? atoi(argv[3]) : 40;
+    int concurrent = argc > 4 ? atoi(argv[4]) : 16;
+    string address = argc > 5 ? argv[5] : "127.0.0.1:25565";
+    int serverPid = argc > 6 ? atoi(argv[6]) : 0;
+    size_t colon = address.rfind(':');
+    shared.host = address.substr(0, colon);
+    shared.httpPort = atoi(address.c_str() + colon + 1);
+
+    // 事先下好的对局：双方都用随机策略
+    shared.scripts.resize(SCRIPT_COUNT);
+    PolicyConfig players[2];
+    ParsePolicy("random", players[0]);
+    ParsePolicy("random", players[1]);
+    PolicyWorker worker;
+    InitPolicyWorker(worker, 1);
+    for (int k = 0; k < SCRIPT_COUNT; k++)
+        PlayGame(players, worker, k + 1, shared.scripts[k]);
+
+    printf("%d matches, up to %d moves each, %d at a time\n", shared.matches, shared.plies, concurrent);
+    if (mode != "tcp")
+        Run(shared, false, concurrent, serverPid);
+    if (mode != "http")
+        Run(shared, true, concurrent, serverPid);
+    return 0;
+}